@@ -0,0 +1,184 @@
+/**
+ * @module topgg
+ * @file bench.h
+ * @brief A tiny benchmark harness for the Top.gg C++ SDK's hot paths.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+#include <mock_server.h>
+
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <optional>
+#include <memory>
+#include <mutex>
+#include <map>
+
+namespace topgg::bench {
+  /**
+   * @brief The measurements of a single benchmark case.
+   *
+   * @since 2.1.0
+   */
+  struct measurement {
+    size_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+    double p50_ns;
+    double p99_ns;
+
+    /**
+     * @brief The highest amount of live heap bytes seen while the case ran, relative to when it started.
+     *
+     * @since 2.1.0
+     */
+    size_t peak_heap_bytes;
+  };
+
+  /**
+   * @brief Passed to every benchmark case. Runs and measures the operation under test.
+   *
+   * @since 2.1.0
+   */
+  class state {
+    std::chrono::milliseconds m_min_time;
+    size_t m_max_iterations;
+    std::optional<measurement> m_result;
+
+  public:
+    inline state(const std::chrono::milliseconds min_time, const size_t max_iterations)
+      : m_min_time(min_time), m_max_iterations(max_iterations) {}
+
+    /**
+     * @brief Repeatedly runs an operation until the minimum time has passed, timing every iteration and counting its heap allocations.
+     * Everything the operation needs should be set up before calling this, as only the operation itself is measured.
+     * A benchmark case calls this exactly once.
+     *
+     * @param op The operation to measure.
+     * @since 2.1.0
+     */
+    void run(const std::function<void()>& op);
+
+    inline const std::optional<measurement>& result() const noexcept {
+      return m_result;
+    }
+  };
+
+  using benchmark_fn = void (*)(state&);
+
+  /**
+   * @brief Registers a benchmark case. Use TOPGG_BENCHMARK instead of calling this directly.
+   *
+   * @since 2.1.0
+   */
+  struct registration {
+    registration(const char* name, benchmark_fn fn);
+  };
+
+  /**
+   * @brief A transport that answers every request in-process with a canned response, so that only the SDK's own work is measured.
+   *
+   * @since 2.1.0
+   */
+  class canned_transport: public transport {
+    dpp::http_request_completion_t m_response;
+
+  public:
+    inline canned_transport(const uint16_t status, const std::string& body) {
+      m_response.status = status;
+      m_response.body = body;
+    }
+
+    inline void request(TOPGG_UNUSED const std::string& url, TOPGG_UNUSED const dpp::http_method method, TOPGG_UNUSED const std::string& body, TOPGG_UNUSED const std::multimap<std::string, std::string>& headers, dpp::http_completion_event&& callback) override {
+      callback(m_response);
+    }
+  };
+
+  /**
+   * @brief Blocks the benchmark thread until an asynchronous client call completes.
+   *
+   * @since 2.1.0
+   */
+  class waiter {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::exception_ptr m_error;
+    bool m_done = false;
+
+  public:
+    /**
+     * @brief Marks the call as completed.
+     *
+     * @param error The error the call failed with, if any. It is rethrown by wait().
+     * @since 2.1.0
+     */
+    void notify(const std::exception_ptr& error = nullptr);
+
+    /**
+     * @brief Parses a result and marks the call as completed, passing any error on to wait().
+     *
+     * @param result The result to parse.
+     * @since 2.1.0
+     */
+    template<typename T>
+    void notify(const result<T>& result) {
+      try {
+        result.get();
+        notify();
+      } catch (...) {
+        notify(std::current_exception());
+      }
+    }
+
+    /**
+     * @brief Waits for notify() and resets the waiter for the next call.
+     *
+     * @throw std::runtime_error If the call didn't complete within ten seconds.
+     * @since 2.1.0
+     */
+    void wait();
+  };
+
+  /**
+   * @brief Returns the D++ cluster shared by every benchmark case. It is never started.
+   *
+   * @since 2.1.0
+   */
+  dpp::cluster& shared_cluster();
+
+  /**
+   * @brief Returns a client whose requests are answered by a canned_transport.
+   *
+   * @since 2.1.0
+   */
+  std::unique_ptr<client> canned_client(const uint16_t status, const std::string& body);
+
+  /**
+   * @brief Returns a client sending its requests through D++ to a local mock server.
+   *
+   * @since 2.1.0
+   */
+  std::unique_ptr<client> mock_client(const mock::server& server);
+}; // namespace topgg::bench
+
+#define TOPGG_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define TOPGG_BENCHMARK_CONCAT(a, b)       TOPGG_BENCHMARK_CONCAT_INNER(a, b)
+
+/**
+ * @brief Defines and registers a benchmark case. The body receives a topgg::bench::state& named state.
+ */
+#define TOPGG_BENCHMARK(name)                                                                                                                                                 \
+  static void TOPGG_BENCHMARK_CONCAT(topgg_benchmark_, __LINE__)(topgg::bench::state & state);                                                                               \
+  static const topgg::bench::registration TOPGG_BENCHMARK_CONCAT(topgg_benchmark_registration_, __LINE__){name, &TOPGG_BENCHMARK_CONCAT(topgg_benchmark_, __LINE__)};        \
+  static void TOPGG_BENCHMARK_CONCAT(topgg_benchmark_, __LINE__)(TOPGG_UNUSED topgg::bench::state & state)
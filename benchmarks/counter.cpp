@@ -0,0 +1,105 @@
+#include "bench.h"
+
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * These gather statistics for a bot in 25 servers per shard, stored in D++'s guild cache.
+ * Benchmark clusters are never started, so they have no shards to call get_guild_count() on. Instead, the stats/walk cases do what
+ * topgg::stats::stats(dpp::cluster&) makes every shard's get_guild_count() do: lock the guild cache and go through all of it, once per shard.
+ */
+
+static constexpr size_t guilds_per_shard = 25;
+
+class guild_fixture {
+  std::vector<dpp::guild*> m_guilds;
+
+public:
+  guild_fixture(const uint32_t shards) {
+    const auto cache = dpp::get_guild_cache();
+
+    m_guilds.reserve(shards * guilds_per_shard);
+
+    for (uint32_t shard_id = 0; shard_id < shards; shard_id++) {
+      for (size_t i = 0; i < guilds_per_shard; i++) {
+        auto guild = new dpp::guild{};
+
+        guild->id = dpp::snowflake{(uint64_t{shard_id} << 32) | (i + 1)};
+        guild->shard_id = static_cast<uint16_t>(shard_id);
+
+        cache->store(guild);
+        m_guilds.push_back(guild);
+      }
+    }
+  }
+
+  guild_fixture(const guild_fixture&) = delete;
+  guild_fixture& operator=(const guild_fixture&) = delete;
+
+  ~guild_fixture() {
+    const auto cache = dpp::get_guild_cache();
+
+    for (const auto guild: m_guilds) {
+      cache->remove(guild);
+    }
+  }
+};
+
+static topgg::stats walk(const uint32_t shards) {
+  const auto cache = dpp::get_guild_cache();
+  std::vector<size_t> counts(shards);
+
+  for (uint32_t shard_id = 0; shard_id < shards; shard_id++) {
+    std::shared_lock lock{cache->get_mutex()};
+
+    for (const auto& entry: cache->get_container()) {
+      if (entry.second->shard_id == shard_id) {
+        counts[shard_id]++;
+      }
+    }
+  }
+
+  return topgg::stats{counts};
+}
+
+static void stats_walk(topgg::bench::state& state, const uint32_t shards) {
+  const guild_fixture guilds{shards};
+
+  state.run([shards]() {
+    walk(shards);
+  });
+}
+
+static void stats_counted(topgg::bench::state& state, const uint32_t shards) {
+  const guild_fixture guilds{shards};
+  dpp::cluster cluster{"bench token", dpp::i_default_intents, shards};
+  const topgg::guild_counter counter{cluster};
+
+  state.run([&counter]() {
+    counter.snapshot();
+  });
+}
+
+TOPGG_BENCHMARK("stats/walk (16 shards)") {
+  stats_walk(state, 16);
+}
+
+TOPGG_BENCHMARK("stats/walk (256 shards)") {
+  stats_walk(state, 256);
+}
+
+TOPGG_BENCHMARK("stats/walk (2048 shards)") {
+  stats_walk(state, 2048);
+}
+
+TOPGG_BENCHMARK("stats/counted (16 shards)") {
+  stats_counted(state, 16);
+}
+
+TOPGG_BENCHMARK("stats/counted (256 shards)") {
+  stats_counted(state, 256);
+}
+
+TOPGG_BENCHMARK("stats/counted (2048 shards)") {
+  stats_counted(state, 2048);
+}
@@ -0,0 +1,96 @@
+#include "bench.h"
+
+#include <stdexcept>
+
+using topgg::bench::mock_client;
+using topgg::bench::waiter;
+
+/**
+ * These send real HTTP requests through D++ to a topgg::mock::server on the loopback interface, one request at a time.
+ */
+
+TOPGG_BENCHMARK("e2e/get_bot") {
+  topgg::mock::server server{topgg::mock::options{}};
+  const auto client = mock_client(server);
+  waiter done{};
+
+  state.run([&client, &done]() {
+    client->get_bot(264811613708746752, [&done](const auto& result) {
+      done.notify(result);
+    });
+
+    done.wait();
+  });
+}
+
+TOPGG_BENCHMARK("e2e/has_voted") {
+  topgg::mock::server server{topgg::mock::options{}};
+  const auto client = mock_client(server);
+  waiter done{};
+
+  state.run([&client, &done]() {
+    client->has_voted(661200758510977084, [&done](const auto& result) {
+      done.notify(result);
+    });
+
+    done.wait();
+  });
+}
+
+TOPGG_BENCHMARK("e2e/get_voters (1k)") {
+  topgg::mock::options opts{};
+  opts.voters = 1000;
+
+  topgg::mock::server server{opts};
+  const auto client = mock_client(server);
+  waiter done{};
+
+  state.run([&client, &done]() {
+    client->get_voters([&done](const auto& result) {
+      done.notify(result);
+    });
+
+    done.wait();
+  });
+}
+
+static void get_voters_e2e(topgg::bench::state& state, const bool gzip) {
+  topgg::mock::options opts{};
+  opts.voters = 10000;
+  opts.gzip = gzip;
+
+  topgg::mock::server server{opts};
+  const auto client = mock_client(server);
+  waiter done{};
+
+  state.run([&client, &done]() {
+    client->get_voters([&done](const auto& result) {
+      done.notify(result);
+    });
+
+    done.wait();
+  });
+}
+
+TOPGG_BENCHMARK("e2e/get_voters (10k)") {
+  get_voters_e2e(state, false);
+}
+
+TOPGG_BENCHMARK("e2e/get_voters (10k, gzip)") {
+  get_voters_e2e(state, true);
+}
+
+TOPGG_BENCHMARK("e2e/post_stats") {
+  topgg::mock::server server{topgg::mock::options{}};
+  const auto client = mock_client(server);
+  const topgg::stats s{std::vector<size_t>(16, 1000)};
+  waiter done{};
+
+  state.run([&client, &s, &done]() {
+    client->post_stats(s, [&done](const bool success) {
+      done.notify(success ? nullptr : std::make_exception_ptr(std::runtime_error{"Unable to post stats."}));
+    });
+
+    done.wait();
+  });
+}
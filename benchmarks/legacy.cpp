@@ -0,0 +1,111 @@
+#include "bench.h"
+
+#include <exception>
+#include <optional>
+#include <string>
+#include <ctime>
+
+using topgg::bench::canned_client;
+
+/**
+ * A copy of how user and user_socials were deserialized before optional fields were read with find_field, kept as a reference.
+ * Every missing or null optional field threw an exception, which was caught and ignored.
+ * The original read keys with const operator[], which is undefined behaviour in nlohmann::json for missing keys, so this copy uses at() instead,
+ * which throws like the original was meant to.
+ */
+
+#define DESERIALIZE(j, name, type) \
+  name = j.at(#name).template get<type>()
+
+#define DESERIALIZE_ALIAS(j, name, prop, type) \
+  prop = j.at(#name).template get<type>()
+
+#define IGNORE_EXCEPTION(scope) \
+  try scope catch (TOPGG_UNUSED const std::exception&) {}
+
+#define DESERIALIZE_OPTIONAL_STRING(j, name)                     \
+  IGNORE_EXCEPTION({                                             \
+    const auto value = j.at(#name).template get<std::string>(); \
+                                                                 \
+    if (value.size() > 0) {                                      \
+      name = std::optional{value};                               \
+    }                                                            \
+  })
+
+namespace legacy {
+  struct user_socials {
+    std::optional<std::string> github;
+    std::optional<std::string> instagram;
+    std::optional<std::string> reddit;
+    std::optional<std::string> twitter;
+    std::optional<std::string> youtube;
+
+    user_socials(const dpp::json& j) {
+      DESERIALIZE_OPTIONAL_STRING(j, github);
+      DESERIALIZE_OPTIONAL_STRING(j, instagram);
+      DESERIALIZE_OPTIONAL_STRING(j, reddit);
+      DESERIALIZE_OPTIONAL_STRING(j, twitter);
+      DESERIALIZE_OPTIONAL_STRING(j, youtube);
+    }
+  };
+
+  struct user {
+    dpp::snowflake id;
+    std::string username;
+    std::string avatar;
+    time_t created_at;
+    std::optional<std::string> bio;
+    std::optional<std::string> banner;
+    std::optional<user_socials> socials;
+    bool is_supporter;
+    bool is_certified_dev;
+    bool is_moderator;
+    bool is_web_moderator;
+    bool is_admin;
+
+    user(const dpp::json& j) {
+      id = dpp::snowflake{j.at("id").template get<std::string>()};
+
+      DESERIALIZE(j, username, std::string);
+
+      try {
+        const auto hash = j.at("avatar").template get<std::string>();
+        const char* ext = hash.rfind("a_", 0) == 0 ? "gif" : "png";
+
+        avatar = "https://cdn.discordapp.com/avatars/" + std::to_string(id) + "/" + hash + "." + ext + "?size=1024";
+      } catch (TOPGG_UNUSED const std::exception&) {
+        avatar = "https://cdn.discordapp.com/embed/avatars/" + std::to_string((id >> 22) % 5) + ".png";
+      }
+
+      created_at = static_cast<time_t>(((id >> 22) / 1000) + 1420070400);
+
+      DESERIALIZE_OPTIONAL_STRING(j, bio);
+      DESERIALIZE_OPTIONAL_STRING(j, banner);
+
+      if (j.contains("socials")) {
+        socials = std::optional{user_socials{j.at("socials").template get<dpp::json>()}};
+      }
+
+      DESERIALIZE_ALIAS(j, supporter, is_supporter, bool);
+      DESERIALIZE_ALIAS(j, certifiedDev, is_certified_dev, bool);
+      DESERIALIZE_ALIAS(j, mod, is_moderator, bool);
+      DESERIALIZE_ALIAS(j, webMod, is_web_moderator, bool);
+      DESERIALIZE_ALIAS(j, admin, is_admin, bool);
+    }
+  };
+} // namespace legacy
+
+/**
+ * Goes through the same request pipeline as parse/user (sparse) in models.cpp, without parsing the result,
+ * then parses the same body with the reference constructors above. The difference between the two cases is the cost of the exceptions.
+ */
+TOPGG_BENCHMARK("parse/user (sparse, legacy macros)") {
+  const auto body = topgg::mock::sparse_user_json(661200758510977084);
+  const auto client = canned_client(200, body);
+
+  state.run([&client, &body]() {
+    client->get_user(661200758510977084, [](TOPGG_UNUSED const auto& result) {});
+
+    const legacy::user parsed{dpp::json::parse(body)};
+  });
+}
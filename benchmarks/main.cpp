@@ -0,0 +1,252 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+#include <new>
+
+using topgg::bench::measurement;
+using topgg::bench::registration;
+using topgg::bench::state;
+using topgg::bench::waiter;
+
+using std::chrono::steady_clock;
+
+/**
+ * Every heap allocation in the process goes through these, so that allocations and live heap bytes can be counted per operation.
+ * The requested size is stored in front of each block, as operator delete isn't always given the size.
+ */
+static std::atomic_size_t allocations{0};
+static std::atomic_size_t allocated_bytes{0};
+static std::atomic_size_t live_bytes{0};
+static std::atomic_size_t peak_live_bytes{0};
+
+static constexpr size_t header_size = alignof(std::max_align_t);
+
+static void* counted_alloc(const size_t size) {
+  auto block = static_cast<char*>(std::malloc(size + header_size));
+
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  *reinterpret_cast<size_t*>(block) = size;
+
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  const auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak = peak_live_bytes.load(std::memory_order_relaxed);
+
+  while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+  return block + header_size;
+}
+
+static void counted_free(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto block = static_cast<char*>(ptr) - header_size;
+
+  live_bytes.fetch_sub(*reinterpret_cast<size_t*>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+void* operator new(size_t size) {
+  return counted_alloc(size);
+}
+
+void* operator new[](size_t size) {
+  return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  counted_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  counted_free(ptr);
+}
+
+void operator delete(void* ptr, TOPGG_UNUSED size_t size) noexcept {
+  counted_free(ptr);
+}
+
+void operator delete[](void* ptr, TOPGG_UNUSED size_t size) noexcept {
+  counted_free(ptr);
+}
+
+static std::vector<std::pair<const char*, topgg::bench::benchmark_fn>>& benchmarks() {
+  static std::vector<std::pair<const char*, topgg::bench::benchmark_fn>> registered{};
+
+  return registered;
+}
+
+registration::registration(const char* name, topgg::bench::benchmark_fn fn) {
+  benchmarks().push_back(std::pair{name, fn});
+}
+
+void state::run(const std::function<void()>& op) {
+  std::vector<double> samples{};
+  samples.reserve(m_max_iterations);
+
+  // warm up caches and any lazily initialized state first.
+  op();
+
+  const auto allocations_before = allocations.load();
+  const auto bytes_before = allocated_bytes.load();
+  const auto live_before = live_bytes.load();
+
+  peak_live_bytes.store(live_before);
+
+  const auto start = steady_clock::now();
+  auto now = start;
+
+  while (samples.size() < m_max_iterations && (samples.size() < 10 || now - start < m_min_time)) {
+    const auto before = steady_clock::now();
+    op();
+    now = steady_clock::now();
+
+    samples.push_back(std::chrono::duration<double, std::nano>(now - before).count());
+  }
+
+  const auto total_ns = std::chrono::duration<double, std::nano>(now - start).count();
+  const auto iterations = static_cast<double>(samples.size());
+
+  measurement result{};
+  result.iterations = samples.size();
+  result.ns_per_op = total_ns / iterations;
+  result.allocs_per_op = static_cast<double>(allocations.load() - allocations_before) / iterations;
+  result.bytes_per_op = static_cast<double>(allocated_bytes.load() - bytes_before) / iterations;
+  result.peak_heap_bytes = peak_live_bytes.load() - live_before;
+
+  std::sort(samples.begin(), samples.end());
+
+  result.p50_ns = samples[samples.size() / 2];
+  result.p99_ns = samples[std::min(samples.size() - 1, static_cast<size_t>(iterations * 0.99))];
+
+  m_result = std::optional{result};
+}
+
+void waiter::notify(const std::exception_ptr& error) {
+  {
+    std::lock_guard lock{m_mutex};
+    m_error = error;
+    m_done = true;
+  }
+
+  m_cv.notify_one();
+}
+
+void waiter::wait() {
+  std::unique_lock lock{m_mutex};
+
+  if (!m_cv.wait_for(lock, std::chrono::seconds{10}, [this]() { return m_done; })) {
+    throw std::runtime_error{"Timed out waiting for the request to complete."};
+  }
+
+  m_done = false;
+
+  if (m_error) {
+    std::rethrow_exception(std::exchange(m_error, nullptr));
+  }
+}
+
+dpp::cluster& topgg::bench::shared_cluster() {
+  static dpp::cluster cluster{"bench token"};
+
+  return cluster;
+}
+
+std::unique_ptr<topgg::client> topgg::bench::canned_client(const uint16_t status, const std::string& body) {
+  auto bench_client = std::make_unique<topgg::client>(shared_cluster(), "bench token");
+
+  bench_client->set_transport(std::make_shared<canned_transport>(status, body));
+
+  return bench_client;
+}
+
+std::unique_ptr<topgg::client> topgg::bench::mock_client(const topgg::mock::server& server) {
+  auto bench_client = std::make_unique<topgg::client>(shared_cluster(), "bench token");
+
+  bench_client->set_base_url("http://127.0.0.1:" + std::to_string(server.port()) + "/api");
+
+  return bench_client;
+}
+
+static void usage(const char* program) {
+  std::fprintf(stderr, "usage: %s [--min-time-ms N] [--max-iterations N] [--csv] [filter]\n", program);
+}
+
+int main(int argc, char** argv) {
+  std::chrono::milliseconds min_time{500};
+  size_t max_iterations = 1000000;
+  const char* filter = nullptr;
+  bool csv = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (std::strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+      min_time = std::chrono::milliseconds{std::strtoull(argv[++i], nullptr, 10)};
+    } else if (std::strcmp(argv[i], "--max-iterations") == 0 && i + 1 < argc) {
+      max_iterations = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    } else if (argv[i][0] != '-' && filter == nullptr) {
+      filter = argv[i];
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (csv) {
+    std::printf("name,iterations,ns_per_op,ops_per_sec,p50_ns,p99_ns,allocs_per_op,bytes_per_op,peak_heap_bytes\n");
+  } else {
+    std::printf("%-40s %10s %12s %12s %12s %12s %10s %12s %12s\n", "benchmark", "iters", "ns/op", "ops/s", "p50 ns", "p99 ns", "allocs/op", "bytes/op", "peak heap");
+  }
+
+  auto& cases = benchmarks();
+
+  std::stable_sort(cases.begin(), cases.end(), [](const auto& a, const auto& b) {
+    return std::strcmp(a.first, b.first) < 0;
+  });
+
+  int failures = 0;
+
+  for (const auto& [name, fn]: cases) {
+    if (filter != nullptr && std::strstr(name, filter) == nullptr) {
+      continue;
+    }
+
+    state current{min_time, max_iterations};
+
+    try {
+      fn(current);
+    } catch (const std::exception& exc) {
+      std::printf(csv ? "%s,failed: %s\n" : "%-40s failed: %s\n", name, exc.what());
+      failures++;
+      continue;
+    } catch (...) {
+      std::printf(csv ? "%s,failed\n" : "%-40s failed\n", name);
+      failures++;
+      continue;
+    }
+
+    if (!current.result().has_value()) {
+      continue;
+    }
+
+    const auto& result = current.result().value();
+
+    std::printf(csv ? "%s,%zu,%.1f,%.0f,%.1f,%.1f,%.2f,%.1f,%zu\n" : "%-40s %10zu %12.1f %12.0f %12.1f %12.1f %10.2f %12.1f %12zu\n", name, result.iterations, result.ns_per_op, result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0.0, result.p50_ns, result.p99_ns, result.allocs_per_op, result.bytes_per_op, result.peak_heap_bytes);
+    std::fflush(stdout);
+  }
+
+  return failures == 0 ? 0 : 1;
+}
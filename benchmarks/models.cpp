@@ -0,0 +1,301 @@
+#include "bench.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <ctime>
+
+using topgg::bench::canned_client;
+
+/**
+ * The request/ cases only go through the client's request pipeline, while the parse/ cases also call result<T>::get().
+ * Subtracting one from the other gives the cost of deserializing the model itself.
+ */
+
+TOPGG_BENCHMARK("request/get_bot") {
+  const auto client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+
+  state.run([&client]() {
+    client->get_bot(264811613708746752, [](TOPGG_UNUSED const auto& result) {});
+  });
+}
+
+TOPGG_BENCHMARK("request/get_bot (metrics)") {
+  const auto client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+
+  client->enable_metrics();
+
+  state.run([&client]() {
+    client->get_bot(264811613708746752, [](TOPGG_UNUSED const auto& result) {});
+  });
+}
+
+TOPGG_BENCHMARK("parse/bot") {
+  const auto client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+
+  state.run([&client]() {
+    client->get_bot(264811613708746752, [](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+/**
+ * Parses bots on the benchmark thread while the given amount of other threads do the same, to show how well parsing scales across D++'s worker threads.
+ * The allocation columns include the other threads' allocations.
+ */
+static void get_bot_contended(topgg::bench::state& state, const size_t threads) {
+  const auto client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+  std::atomic_bool stop{false};
+  std::vector<std::thread> workers{};
+
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back([&stop]() {
+      const auto worker_client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+
+      while (!stop.load(std::memory_order_relaxed)) {
+        worker_client->get_bot(264811613708746752, [](const auto& result) {
+          result.get();
+        });
+      }
+    });
+  }
+
+  state.run([&client]() {
+    client->get_bot(264811613708746752, [](const auto& result) {
+      result.get();
+    });
+  });
+
+  stop.store(true, std::memory_order_relaxed);
+
+  for (auto& worker: workers) {
+    worker.join();
+  }
+}
+
+TOPGG_BENCHMARK("parse/bot (+3 threads)") {
+  get_bot_contended(state, 3);
+}
+
+TOPGG_BENCHMARK("parse/bot (+7 threads)") {
+  get_bot_contended(state, 7);
+}
+
+/**
+ * The way bot::approved_at used to be read, kept here as a reference for the ISO-8601 parser that replaced it.
+ * mktime reads the local timezone and takes libc's timezone lock on every call.
+ */
+static time_t legacy_parse_date(const std::string& date) {
+  tm date_tm{};
+
+  strptime(date.c_str(), "%Y-%m-%dT%H:%M:%S", &date_tm);
+
+  return mktime(&date_tm);
+}
+
+static const std::string bot_date{"2017-04-26T18:08:17.125Z"};
+
+/**
+ * Converts the mock bot's approval date on the benchmark thread while the given amount of other threads do the same,
+ * in the same shape as the parse/bot cases above.
+ */
+static void legacy_date_contended(topgg::bench::state& state, const size_t threads) {
+  std::atomic_bool stop{false};
+  std::vector<std::thread> workers{};
+
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back([&stop]() {
+      while (!stop.load(std::memory_order_relaxed)) {
+        legacy_parse_date(bot_date);
+      }
+    });
+  }
+
+  state.run([]() {
+    legacy_parse_date(bot_date);
+  });
+
+  stop.store(true, std::memory_order_relaxed);
+
+  for (auto& worker: workers) {
+    worker.join();
+  }
+}
+
+TOPGG_BENCHMARK("parse/date (strptime+mktime)") {
+  legacy_date_contended(state, 0);
+}
+
+TOPGG_BENCHMARK("parse/date (strptime+mktime, +3 threads)") {
+  legacy_date_contended(state, 3);
+}
+
+TOPGG_BENCHMARK("parse/date (strptime+mktime, +7 threads)") {
+  legacy_date_contended(state, 7);
+}
+
+TOPGG_BENCHMARK("parse/user") {
+  const auto client = canned_client(200, topgg::mock::user_json(661200758510977084));
+
+  state.run([&client]() {
+    client->get_user(661200758510977084, [](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+/**
+ * Every optional field is null or missing. Compare with parse/user (sparse, legacy macros) in legacy.cpp.
+ */
+TOPGG_BENCHMARK("parse/user (sparse)") {
+  const auto client = canned_client(200, topgg::mock::sparse_user_json(661200758510977084));
+
+  state.run([&client]() {
+    client->get_user(661200758510977084, [](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("parse/stats (16 shards)") {
+  const auto client = canned_client(200, topgg::mock::stats_json(16));
+
+  state.run([&client]() {
+    client->get_stats([](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("parse/has_voted") {
+  const auto client = canned_client(200, "{\"voted\":1}");
+
+  state.run([&client]() {
+    client->has_voted(661200758510977084, [](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+static void get_voters(topgg::bench::state& state, const size_t count) {
+  const auto client = canned_client(200, topgg::mock::voters_json(count));
+
+  state.run([&client]() {
+    client->get_voters([](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("parse/voters (100)") {
+  get_voters(state, 100);
+}
+
+TOPGG_BENCHMARK("parse/voters (1k)") {
+  get_voters(state, 1000);
+}
+
+TOPGG_BENCHMARK("parse/voters (10k)") {
+  get_voters(state, 10000);
+}
+
+TOPGG_BENCHMARK("parse/voters (100k)") {
+  get_voters(state, 100000);
+}
+
+/**
+ * The same voters, gzip-compressed by Top.gg. These include inflating the body.
+ */
+static void get_voters_gzip(topgg::bench::state& state, const size_t count) {
+  const auto client = canned_client(200, topgg::mock::gzip(topgg::mock::voters_json(count)));
+
+  state.run([&client]() {
+    client->get_voters([](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("parse/voters (1k, gzip)") {
+  get_voters_gzip(state, 1000);
+}
+
+TOPGG_BENCHMARK("parse/voters (10k, gzip)") {
+  get_voters_gzip(state, 10000);
+}
+
+static void get_voter_list(topgg::bench::state& state, const size_t count) {
+  const auto client = canned_client(200, topgg::mock::voters_json(count));
+
+  state.run([&client]() {
+    client->get_voter_list([](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("parse/voter_list (100)") {
+  get_voter_list(state, 100);
+}
+
+TOPGG_BENCHMARK("parse/voter_list (1k)") {
+  get_voter_list(state, 1000);
+}
+
+TOPGG_BENCHMARK("parse/voter_list (10k)") {
+  get_voter_list(state, 10000);
+}
+
+TOPGG_BENCHMARK("parse/voter_list (100k)") {
+  get_voter_list(state, 100000);
+}
+
+TOPGG_BENCHMARK("parse/voter_list (10k, gzip)") {
+  const auto client = canned_client(200, topgg::mock::gzip(topgg::mock::voters_json(10000)));
+
+  state.run([&client]() {
+    client->get_voter_list([](const auto& result) {
+      result.get();
+    });
+  });
+}
+
+TOPGG_BENCHMARK("result/get (memoized)") {
+  const auto client = canned_client(200, topgg::mock::bot_json(264811613708746752));
+  std::optional<topgg::result<topgg::bot>> parsed{};
+
+  client->get_bot(264811613708746752, [&parsed](const auto& result) {
+    parsed.emplace(result);
+  });
+
+  state.run([&parsed]() {
+    parsed->get();
+  });
+}
+
+static void post_stats(topgg::bench::state& state, const size_t shards) {
+  const auto client = canned_client(200, "{}");
+  const topgg::stats s{std::vector<size_t>(shards, 1000)};
+
+  state.run([&client, &s]() {
+    client->post_stats(s, [](TOPGG_UNUSED const bool success) {});
+  });
+}
+
+TOPGG_BENCHMARK("serialize/post_stats (1 shard)") {
+  post_stats(state, 1);
+}
+
+TOPGG_BENCHMARK("serialize/post_stats (16 shards)") {
+  post_stats(state, 16);
+}
+
+TOPGG_BENCHMARK("serialize/post_stats (256 shards)") {
+  post_stats(state, 256);
+}
+
+TOPGG_BENCHMARK("serialize/post_stats (2048 shards)") {
+  post_stats(state, 2048);
+}
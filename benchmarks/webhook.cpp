@@ -0,0 +1,121 @@
+#include "bench.h"
+
+#ifdef __linux__
+
+#include <system_error>
+#include <string_view>
+#include <stdexcept>
+#include <string>
+
+#include <netinet/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using topgg::bench::shared_cluster;
+
+/**
+ * These send vote webhooks to a topgg::webhook_server on the loopback interface, one request at a time, and wait for every response.
+ * The ops/s column is the amount of requests per second a single client gets through.
+ */
+
+static const std::string vote_request = [] {
+  const std::string body{"{\"bot\":\"264811613708746752\",\"user\":\"661200758510977084\",\"type\":\"upvote\",\"isWeekend\":false,\"query\":\"?ref=bench&a=1\"}"};
+
+  return "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: benchmark secret\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}();
+
+/**
+ * A minimal blocking HTTP client that only understands responses without a body.
+ */
+class http_client {
+  int m_fd;
+
+public:
+  http_client(const uint16_t port)
+    : m_fd(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) {
+    if (m_fd < 0) {
+      throw std::system_error{errno, std::generic_category(), "socket"};
+    }
+
+    sockaddr_in remote{};
+
+    remote.sin_family = AF_INET;
+    remote.sin_port = htons(port);
+    remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const int no_delay = 1;
+
+    ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+    if (::connect(m_fd, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote)) < 0) {
+      const auto error = errno;
+
+      ::close(m_fd);
+
+      throw std::system_error{error, std::generic_category(), "connect"};
+    }
+  }
+
+  http_client(const http_client&) = delete;
+  http_client& operator=(const http_client&) = delete;
+
+  void post(const std::string& request) {
+    if (::send(m_fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+      throw std::runtime_error{"Couldn't send the request."};
+    }
+
+    char response[256];
+    size_t length = 0;
+
+    while (length < 4 || std::string_view{response, length}.find("\r\n\r\n") == std::string_view::npos) {
+      const auto received = ::recv(m_fd, response + length, sizeof(response) - length, 0);
+
+      if (received <= 0) {
+        throw std::runtime_error{"The connection was closed before a response was received."};
+      }
+
+      length += static_cast<size_t>(received);
+    }
+
+    if (std::string_view{response, length}.substr(0, 12) != "HTTP/1.1 204") {
+      throw std::runtime_error{"Unexpected response: " + std::string{response, length}};
+    }
+  }
+
+  /**
+   * Resets the connection instead of leaving it in TIME_WAIT, so that opening one per request doesn't run out of local ports.
+   */
+  ~http_client() {
+    const linger reset{1, 0};
+
+    ::setsockopt(m_fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    ::close(m_fd);
+  }
+};
+
+TOPGG_BENCHMARK("webhook/vote (keep-alive)") {
+  topgg::webhook_server server{shared_cluster(), 0, "benchmark secret", [](TOPGG_UNUSED const auto& vote) {}, "127.0.0.1"};
+  http_client client{server.port()};
+
+  state.run([&client]() {
+    client.post(vote_request);
+  });
+
+  server.stop();
+}
+
+TOPGG_BENCHMARK("webhook/vote (new connection)") {
+  topgg::webhook_server server{shared_cluster(), 0, "benchmark secret", [](TOPGG_UNUSED const auto& vote) {}, "127.0.0.1"};
+
+  state.run([&server]() {
+    http_client client{server.port()};
+
+    client.post(vote_request);
+  });
+
+  server.stop();
+}
+
+#endif
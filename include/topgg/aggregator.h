@@ -0,0 +1,148 @@
+/**
+ * @module topgg
+ * @file aggregator.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#ifndef _WIN32
+
+#include <unordered_map>
+#include <string_view>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace topgg {
+  /**
+   * @brief A snapshot of the stats aggregator's state.
+   *
+   * @see topgg::client::enable_stats_aggregation
+   * @see topgg::client::aggregator_stats
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT aggregation_stats {
+    /**
+     * @brief Whether this process is the leader, the only process that posts the merged statistics.
+     *
+     * @since 2.1.0
+     */
+    bool leader;
+
+    /**
+     * @brief The amount of shards whose server counts are currently known by the leader. Always zero on other processes.
+     *
+     * @since 2.1.0
+     */
+    size_t known_shards;
+
+    /**
+     * @brief The amount of updates received from other processes.
+     *
+     * @since 2.1.0
+     */
+    size_t received;
+
+    /**
+     * @brief The amount of updates that couldn't be read and were ignored.
+     *
+     * @since 2.1.0
+     */
+    size_t malformed;
+  };
+
+  class client;
+
+  /**
+   * @brief Merges the server counts of every shard across several processes running the same bot, on the same machine.
+   *
+   * Every process publishes its own shards' server counts over a Unix domain datagram socket. The process holding an exclusive lock on
+   * the socket path followed by .lock is the leader: it owns the socket, merges every update it receives and is the only one to post statistics.
+   * The lock is released by the operating system when the leader exits, and another process takes over on its next update.
+   *
+   * The socket is only accessible to processes running as the same user. Updates claiming more than 65536 shards, or a shard outside of their own shard count, are counted as malformed and ignored.
+   *
+   * @note This class is not available on Windows.
+   * @see topgg::client::enable_stats_aggregation
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT stats_aggregator {
+    struct shard_entry {
+      size_t server_count;
+      std::chrono::steady_clock::time_point updated_at;
+    };
+
+    std::mutex m_mutex;
+    dpp::cluster& m_cluster;
+    std::string m_path;
+    std::chrono::seconds m_interval;
+    dpp::timer m_timer;
+    int m_lock;
+    int m_socket;
+    bool m_leader;
+    bool m_changed;
+    uint32_t m_shard_count;
+    std::unordered_map<uint32_t, shard_entry> m_shards;
+    std::vector<char> m_buffer;
+    size_t m_received;
+    size_t m_malformed;
+
+    stats_aggregator(dpp::cluster& cluster, const std::string& path, const time_t interval);
+
+    void update();
+    bool try_lead();
+    std::string local_update() const;
+    bool merge(std::string_view update, const std::chrono::steady_clock::time_point now);
+    void receive(const std::chrono::steady_clock::time_point now);
+    void publish(const std::string& update) const noexcept;
+    bool is_leader() noexcept;
+    bool take_changed() noexcept;
+    ::topgg::stats merged();
+
+  public:
+    stats_aggregator() = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    stats_aggregator(const stats_aggregator& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return stats_aggregator The current modified object.
+     * @since 2.1.0
+     */
+    stats_aggregator& operator=(const stats_aggregator& other) = delete;
+
+    /**
+     * @brief Returns a snapshot of this aggregator's state.
+     *
+     * @return aggregation_stats A snapshot of this aggregator's state.
+     * @since 2.1.0
+     */
+    aggregation_stats stats() noexcept;
+
+    /**
+     * @brief The destructor. Stops publishing, and gives up leadership if this process is the leader.
+     */
+    ~stats_aggregator();
+
+    friend class client;
+  };
+}; // namespace topgg
+
+#endif
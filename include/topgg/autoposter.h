@@ -0,0 +1,267 @@
+/**
+ * @module topgg
+ * @file autoposter.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <functional>
+#include <optional>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <mutex>
+
+namespace topgg {
+  /**
+   * @brief The outcome of a single autopost.
+   *
+   * @see topgg::autopost_options::on_success
+   * @see topgg::autopost_options::on_failure
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT autopost_event {
+    /**
+     * @brief Whether Top.gg accepted the statistics.
+     *
+     * @since 2.1.0
+     */
+    bool success;
+
+    /**
+     * @brief The HTTP status code of Top.gg's response, or zero if no response was received.
+     *
+     * @since 2.1.0
+     */
+    uint16_t status;
+
+    /**
+     * @brief The D++ HTTP error, or dpp::h_success if a response was received.
+     *
+     * @since 2.1.0
+     */
+    dpp::http_error error;
+
+    /**
+     * @brief The time it took to post, including every retry attempt.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::milliseconds latency;
+
+    /**
+     * @brief The amount of attempts made, including the first one.
+     *
+     * @since 2.1.0
+     */
+    size_t attempts;
+
+    /**
+     * @brief The amount of seconds Top.gg asked to wait for before posting again, or zero if the post wasn't ratelimited.
+     *
+     * @since 2.1.0
+     */
+    uint16_t retry_after;
+
+    /**
+     * @brief The amount of posts that failed in a row, including this one. Always zero on success.
+     *
+     * @since 2.1.0
+     */
+    size_t consecutive_failures;
+  };
+
+  /**
+   * @brief The callback function to call after an autopost.
+   *
+   * @see topgg::autopost_options
+   * @since 2.1.0
+   */
+  using autopost_observer_t = std::function<void(const autopost_event&)>;
+
+  /**
+   * @brief Configures when the autoposter posts your bot's statistics.
+   *
+   * @see topgg::client::start_autoposter
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT autopost_options {
+    /**
+     * @brief Whether to post shortly after servers are joined or left, instead of only on a fixed interval. Defaults to false.
+     *
+     * Joins and leaves within a few seconds of each other are coalesced into a single post.
+     *
+     * @since 2.1.0
+     */
+    bool on_guild_events = false;
+
+    /**
+     * @brief The minimum amount of seconds between two posts triggered by server joins or leaves. Only used if on_guild_events is true. Defaults to 5 minutes.
+     *
+     * @since 2.1.0
+     */
+    time_t min_interval = 300;
+
+    /**
+     * @brief The maximum amount of seconds between two posts. Defaults to 30 minutes.
+     *
+     * @since 2.1.0
+     */
+    time_t max_interval = 1800;
+
+    /**
+     * @brief The callback function to call after statistics were posted successfully, if any.
+     *
+     * @since 2.1.0
+     */
+    autopost_observer_t on_success;
+
+    /**
+     * @brief The callback function to call after statistics failed to be posted, if any.
+     *
+     * A ratelimited post is tried again as soon as Top.gg's retry_after window ends, instead of on the next interval.
+     *
+     * @since 2.1.0
+     */
+    autopost_observer_t on_failure;
+  };
+
+  /**
+   * @brief A snapshot of the autoposter's counters.
+   *
+   * @see topgg::client::start_autoposter
+   * @see topgg::client::autoposter_stats
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT autopost_stats {
+    /**
+     * @brief The amount of statistics successfully posted.
+     *
+     * @since 2.1.0
+     */
+    size_t posted;
+
+    /**
+     * @brief The amount of posts skipped because the statistics haven't changed since the last successful post.
+     *
+     * @since 2.1.0
+     */
+    size_t skipped;
+
+    /**
+     * @brief The amount of posts that failed, including ones whose statistics callback threw.
+     *
+     * @since 2.1.0
+     */
+    size_t failed;
+
+    /**
+     * @brief The amount of posts that were ratelimited by Top.gg.
+     *
+     * @since 2.1.0
+     */
+    size_t ratelimited;
+
+    /**
+     * @brief The amount of posts that failed in a row since the last successful post.
+     *
+     * @since 2.1.0
+     */
+    size_t consecutive_failures;
+
+    /**
+     * @brief When statistics were last posted successfully, if ever.
+     *
+     * @since 2.1.0
+     */
+    std::optional<std::chrono::system_clock::time_point> last_posted_at;
+
+    /**
+     * @brief A description of the last failure, if the last post failed.
+     *
+     * @since 2.1.0
+     */
+    std::optional<std::string> last_error;
+
+    /**
+     * @brief The time the last post took, including every retry attempt.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::milliseconds last_latency;
+  };
+
+  class client;
+
+  /**
+   * @brief Decides when statistics are due, and remembers a hash of the last statistics posted so that unchanged ones aren't posted again.
+   *
+   * @see topgg::client::start_autoposter
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT autoposter {
+    std::mutex m_mutex;
+    dpp::cluster& m_cluster;
+    std::function<::topgg::stats(dpp::cluster&)> m_callback;
+    autopost_options m_options;
+    dpp::event_handle m_guild_create;
+    dpp::event_handle m_guild_delete;
+    std::atomic_bool m_dirty;
+    bool m_posting;
+    std::optional<size_t> m_last_hash;
+    std::chrono::steady_clock::time_point m_last_attempt;
+    std::optional<std::chrono::steady_clock::time_point> m_retry_at;
+    autopost_stats m_stats;
+    std::string m_body;
+
+    autoposter(dpp::cluster& cluster, const std::function<::topgg::stats(dpp::cluster&)>& callback, const autopost_options& options);
+
+    time_t tick_interval() const noexcept;
+    std::optional<std::pair<std::string, size_t>> next();
+    void complete(const size_t hash, const dpp::http_request_completion_t& response, const size_t attempts, const uint16_t retry_after, const std::chrono::steady_clock::time_point started_at);
+    void failed(std::string&& error);
+
+  public:
+    autoposter() = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    autoposter(const autoposter& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return autoposter The current modified object.
+     * @since 2.1.0
+     */
+    autoposter& operator=(const autoposter& other) = delete;
+
+    /**
+     * @brief Returns a snapshot of this autoposter's counters.
+     *
+     * @return autopost_stats A snapshot of this autoposter's counters.
+     * @since 2.1.0
+     */
+    autopost_stats stats() noexcept;
+
+    /**
+     * @brief The destructor. Stops listening to server joins and leaves.
+     */
+    ~autoposter();
+
+    friend class client;
+  };
+}; // namespace topgg
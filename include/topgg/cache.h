@@ -0,0 +1,68 @@
+/**
+ * @module topgg
+ * @file cache.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <unordered_map>
+#include <optional>
+#include <chrono>
+#include <mutex>
+#include <list>
+
+namespace topgg {
+  class client;
+
+  /**
+   * @brief A bounded, in-process LRU cache of has_voted results.
+   *
+   * @see topgg::client::enable_vote_cache
+   * @see topgg::client::has_voted
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT vote_cache {
+    struct entry {
+      dpp::snowflake user_id;
+      bool voted;
+      std::chrono::steady_clock::time_point expires_at;
+    };
+
+    std::mutex m_mutex;
+    std::list<entry> m_entries;
+    std::unordered_map<dpp::snowflake, std::list<entry>::iterator> m_index;
+    std::chrono::seconds m_ttl;
+    std::chrono::seconds m_voted_ttl;
+    size_t m_max_size;
+
+    vote_cache(const time_t ttl, const time_t voted_ttl, const size_t max_size);
+
+    void store(const dpp::snowflake user_id, const bool voted, const std::chrono::seconds ttl);
+
+    std::optional<bool> get(const dpp::snowflake user_id);
+    void insert(const dpp::snowflake user_id, const bool voted);
+    void insert_vote(const dpp::snowflake user_id);
+    void invalidate(const dpp::snowflake user_id);
+    void clear();
+
+  public:
+    vote_cache() = delete;
+
+    /**
+     * @brief Returns the amount of entries currently stored in this cache, including expired entries that haven't been evicted yet.
+     *
+     * @return size_t The amount of entries currently stored in this cache.
+     * @since 2.1.0
+     */
+    size_t size() noexcept;
+
+    friend class client;
+  };
+}; // namespace topgg
@@ -12,9 +12,14 @@
 
 #include <topgg/topgg.h>
 
+#include <unordered_map>
 #include <functional>
+#include <typeindex>
 #include <vector>
 #include <string>
+#include <optional>
+#include <memory>
+#include <mutex>
 #include <map>
 
 namespace topgg {
@@ -50,6 +55,14 @@ namespace topgg {
    */
   using get_voters_completion_t = std::function<void(const result<std::vector<voter>>&)>;
 
+  /**
+   * @brief The callback function to call when get_voter_list completes.
+   *
+   * @see topgg::client::get_voter_list
+   * @since 2.1.0
+   */
+  using get_voter_list_completion_t = std::function<void(const result<voter_list>&)>;
+
   /**
    * @brief The callback function to call when has_voted completes.
    *
@@ -58,6 +71,14 @@ namespace topgg {
    */
   using has_voted_completion_t = std::function<void(const result<bool>&)>;
 
+  /**
+   * @brief The callback function to call when has_voted_many completes.
+   *
+   * @see topgg::client::has_voted_many
+   * @since 2.1.0
+   */
+  using has_voted_many_completion_t = std::function<void(const result<std::unordered_map<dpp::snowflake, bool>>&)>;
+
   /**
    * @brief The callback function to call when is_weekend completes.
    *
@@ -81,6 +102,51 @@ namespace topgg {
    * @since 2.0.0
    */
   using custom_autopost_callback_t = std::function<::topgg::stats(dpp::cluster&)>;
+
+  /**
+   * @brief A policy describing which failed requests are retried, and how long to wait before each retry.
+   *
+   * The delay before the n-th retry is base_delay * 2^(n - 1) seconds, randomly spread by up to jitter of itself in both directions.
+   *
+   * @see topgg::client::set_retry_policy
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT retry_policy {
+    /**
+     * @brief The maximum amount of attempts, including the first one. Defaults to 3.
+     *
+     * @since 2.1.0
+     */
+    size_t max_attempts = 3;
+
+    /**
+     * @brief The delay before the first retry in seconds. Defaults to one second.
+     *
+     * @since 2.1.0
+     */
+    time_t base_delay = 1;
+
+    /**
+     * @brief The fraction of each delay that is randomized, between 0 and 1. Defaults to 0.5.
+     *
+     * @since 2.1.0
+     */
+    double jitter = 0.5;
+
+    /**
+     * @brief The D++ HTTP errors that are worth retrying.
+     *
+     * @since 2.1.0
+     */
+    std::vector<dpp::http_error> retryable_errors{dpp::h_connection, dpp::h_read, dpp::h_write, dpp::h_ssl_connection};
+
+    /**
+     * @brief Whether 5xx responses from Top.gg are retried. Defaults to true.
+     *
+     * @since 2.1.0
+     */
+    bool retry_server_errors = true;
+  };
   
   /**
    * @brief Main client class that lets you make HTTP requests with the Top.gg API.
@@ -88,14 +154,116 @@ namespace topgg {
    * @since 2.0.0
    */
   class TOPGG_EXPORT client {
-    std::multimap<std::string, std::string> m_headers;
+    using headers_t = std::multimap<std::string, std::string>;
+
+    /**
+     * Retries that are waiting for their timer, each next to the callback that reports its last response if it's cancelled.
+     * The client stops and reports them all when it's destroyed, and no new one is started afterwards.
+     */
+    struct retry_timers {
+      struct retry {
+        bool claimed = false;
+        std::function<void()> cancel;
+      };
+
+      std::mutex mutex;
+      std::unordered_map<dpp::timer, std::shared_ptr<retry>> pending;
+      bool stopped = false;
+    };
+
+    /**
+     * Everything a request needs once it has been handed off. Every request shares this immutable block, changing it means swapping in a new block.
+     * Response callbacks capture the block instead of the client, so they stay valid even if the client is destroyed while requests are in flight.
+     */
+    struct request_context {
+      dpp::cluster& cluster;
+      headers_t headers;
+      std::shared_ptr<::topgg::transport> transport;
+      std::string base_url;
+      size_t max_body_size;
+      std::shared_ptr<ratelimiter> limiter;
+      std::shared_ptr<metrics_registry> metrics;
+      std::optional<retry_policy> retry;
+      std::shared_ptr<retry_timers> timers;
+    };
+
+    std::shared_ptr<const request_context> m_context;
     std::string m_token;
     dpp::cluster& m_cluster;
     dpp::timer m_autoposter_timer;
+    std::shared_ptr<autoposter> m_autoposter;
+    std::shared_ptr<vote_cache> m_vote_cache;
+    std::shared_ptr<guild_counter> m_guild_counter;
+#ifndef _WIN32
+    std::shared_ptr<stats_aggregator> m_aggregator;
+#endif
+
+    void update_context(const std::function<void(request_context&)>& update);
+    static void send(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dpp::http_completion_event&& callback);
+    static dpp::http_completion_event track(const std::shared_ptr<metrics_registry>& metrics, const std::string& url, const dpp::http_method method, dpp::http_completion_event&& callback);
+    static void throttled_send(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dpp::http_completion_event&& callback, const bool can_requeue);
+
+    using dispatch_completion_t = std::function<void(const dpp::http_request_completion_t&, const size_t attempts)>;
+
+    static void dispatch(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dispatch_completion_t&& callback, const size_t attempt);
+    void dispatch(const std::string& url, const dpp::http_method method, const std::string& body, dispatch_completion_t&& callback);
+
+    /**
+     * GET requests that are still in flight, keyed by URL. Identical requests sent meanwhile wait for the same response instead of sending their own.
+     */
+    struct inflight_requests {
+      std::mutex mutex;
+      std::unordered_map<std::string, std::pair<std::type_index, std::shared_ptr<void>>> requests;
+    };
+
+    std::shared_ptr<inflight_requests> m_inflight;
+
+    struct vote_fallback;
+
+    static void check_fallback_votes(const std::shared_ptr<const request_context>& context, const std::shared_ptr<vote_cache>& cache, const std::shared_ptr<vote_fallback>& fallback);
+
+    template<typename T>
+    void raw_request(const std::string& url, const std::function<void(const result<T>&)>& callback, std::function<T(const std::string&)>&& parse_fn) {
+      using waiters_t = std::vector<std::function<void(const result<T>&)>>;
+
+      const std::type_index type{typeid(T)};
+      auto waiters = std::make_shared<waiters_t>(1, callback);
+
+      {
+        std::lock_guard lock{m_inflight->mutex};
+
+        const auto existing = m_inflight->requests.find(url);
+
+        if (existing == m_inflight->requests.end()) {
+          m_inflight->requests.insert(std::pair(url, std::pair(type, waiters)));
+        } else if (existing->second.first == type) {
+          std::static_pointer_cast<waiters_t>(existing->second.second)->push_back(callback);
+          return;
+        }
+      }
+
+      dispatch(url, dpp::m_get, "", [inflight = m_inflight, url, waiters, parse_fn_in = std::move(parse_fn), max_body_size = m_context->max_body_size](const auto& response, const size_t attempts) {
+        {
+          std::lock_guard lock{inflight->mutex};
+
+          const auto existing = inflight->requests.find(url);
+
+          if (existing != inflight->requests.end() && existing->second.second == waiters) {
+            inflight->requests.erase(existing);
+          }
+        }
+
+        const result<T> shared_result{response, parse_fn_in, attempts, max_body_size};
+
+        for (const auto& waiter: *waiters) {
+          waiter(shared_result);
+        }
+      });
+    }
 
     template<typename T>
     void basic_request(const std::string& url, const std::function<void(const result<T>&)>& callback, std::function<T(const dpp::json&)>&& conversion_fn) {
-      m_cluster.request("https://top.gg/api" + url, dpp::m_get, [callback, conversion_fn_in = std::move(conversion_fn)](const auto& response) { callback(result<T>{response, conversion_fn_in}); }, "", "application/json", m_headers);
+      raw_request<T>(url, callback, [conversion_fn_in = std::move(conversion_fn)](const std::string& body) { return conversion_fn_in(dpp::json::parse(body)); });
     }
     
   public:
@@ -408,6 +576,77 @@ namespace topgg {
     topgg::async_result<std::vector<voter>> co_get_voters();
 #endif
 
+    /**
+     * @brief Fetches your Discord bot’s last 1000 voters as a compact voter_list.
+     *
+     * Unlike get_voters, no strings are allocated per voter: every username and avatar hash is stored in one buffer, and avatar URLs are only built when asked for.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.get_voter_list([](const auto& result) {
+     *   try {
+     *     const auto& voters = result.get();
+     *
+     *     for (const auto voter: voters) {
+     *       std::cout << voter.username << std::endl;
+     *     }
+     *   } catch (const std::exception& exc) {
+     *     std::cout << "error: " << exc.what() << std::endl;
+     *   }
+     * });
+     * ```
+     *
+     * @param callback The callback function to call when get_voter_list completes.
+     * @note For its C++20 coroutine counterpart, see co_get_voter_list.
+     * @see topgg::result
+     * @see topgg::voter_list
+     * @see topgg::voter_view
+     * @see topgg::client::get_voters
+     * @see topgg::client::co_get_voter_list
+     * @since 2.1.0
+     */
+    void get_voter_list(const get_voter_list_completion_t& callback);
+
+#ifdef DPP_CORO
+    /**
+     * @brief Fetches your Discord bot’s last 1000 voters as a compact voter_list through a C++20 coroutine.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * try {
+     *   const auto voters = co_await topgg_client.co_get_voter_list();
+     *
+     *   for (const auto voter: voters) {
+     *     std::cout << voter.username << std::endl;
+     *   }
+     * } catch (const std::exception& exc) {
+     *   std::cout << "error: " << exc.what() << std::endl;
+     * }
+     * ```
+     *
+     * @throw topgg::internal_server_error Thrown when the client receives an unexpected error from Top.gg's end.
+     * @throw topgg::invalid_token Thrown when its known that the client uses an invalid Top.gg API token.
+     * @throw topgg::not_found Thrown when such query does not exist.
+     * @throw topgg::ratelimited Thrown when the client gets ratelimited from sending more HTTP requests.
+     * @throw dpp::http_error Thrown when an unexpected HTTP exception occured.
+     * @return co_await to retrieve a voter_list if successful
+     * @note For its C++17 callback-based counterpart, see get_voter_list.
+     * @see topgg::async_result
+     * @see topgg::voter_list
+     * @see topgg::client::get_voter_list
+     * @since 2.1.0
+     */
+    topgg::async_result<voter_list> co_get_voter_list();
+#endif
+
     /**
      * @brief Checks if the specified user has voted your Discord bot.
      *
@@ -430,6 +669,7 @@ namespace topgg {
      *
      * @param user_id The Discord user ID to check from.
      * @param callback The callback function to call when has_voted completes.
+     * @note If the vote cache is enabled and holds this user, the callback is called immediately without sending an HTTP request.
      * @note For its C++20 coroutine counterpart, see co_has_voted.
      * @see topgg::result
      * @see topgg::stats
@@ -477,6 +717,202 @@ namespace topgg {
     topgg::async_result<bool> co_has_voted(const dpp::snowflake user_id);
 #endif
 
+    /**
+     * @brief Checks if each of the specified users has voted your Discord bot, using as few HTTP requests as possible.
+     *
+     * The bot's recent voters list is fetched once and every user is looked up in it. If the list holds every vote, meaning it isn't truncated at 1000 entries,
+     * users missing from it are reported as not having voted. The list doesn't say when a vote was cast, so users found in it, and every user if the list is truncated,
+     * fall back to individual has_voted requests, which only count votes cast within the last 12 hours.
+     * At most 4 of those requests are in flight at once, and they go through the rate limiter if it's enabled. The first one to fail fails the whole call.
+     * Users held by the vote cache, if enabled, are answered from it.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.has_voted_many({661200758510977084, 264811613708746752}, [](const auto& result) {
+     *   try {
+     *     for (const auto& [user_id, voted]: result.get()) {
+     *       std::cout << user_id << ": " << voted << std::endl;
+     *     }
+     *   } catch (const std::exception& exc) {
+     *     std::cout << "error: " << exc.what() << std::endl;
+     *   }
+     * });
+     * ```
+     *
+     * @param user_ids The Discord user IDs to check from.
+     * @param callback The callback function to call when has_voted_many completes.
+     * @note For its C++20 coroutine counterpart, see co_has_voted_many.
+     * @see topgg::result
+     * @see topgg::client::has_voted
+     * @see topgg::client::get_voters
+     * @see topgg::client::co_has_voted_many
+     * @since 2.1.0
+     */
+    void has_voted_many(const std::vector<dpp::snowflake>& user_ids, const has_voted_many_completion_t& callback);
+
+#ifdef DPP_CORO
+    /**
+     * @brief Checks if each of the specified users has voted your Discord bot through a C++20 coroutine, using as few HTTP requests as possible.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * try {
+     *   const auto statuses = co_await topgg_client.co_has_voted_many({661200758510977084, 264811613708746752});
+     *
+     *   for (const auto& [user_id, voted]: statuses) {
+     *     std::cout << user_id << ": " << voted << std::endl;
+     *   }
+     * } catch (const std::exception& exc) {
+     *   std::cout << "error: " << exc.what() << std::endl;
+     * }
+     * ```
+     *
+     * @param user_ids The Discord user IDs to check from.
+     * @throw topgg::internal_server_error Thrown when the client receives an unexpected error from Top.gg's end.
+     * @throw topgg::invalid_token Thrown when its known that the client uses an invalid Top.gg API token.
+     * @throw topgg::not_found Thrown when such query does not exist.
+     * @throw topgg::ratelimited Thrown when the client gets ratelimited from sending more HTTP requests.
+     * @throw dpp::http_error Thrown when an unexpected HTTP exception occured.
+     * @return co_await to retrieve a std::unordered_map<dpp::snowflake, bool> if successful
+     * @note For its C++17 callback-based counterpart, see has_voted_many.
+     * @see topgg::async_result
+     * @see topgg::client::has_voted_many
+     * @since 2.1.0
+     */
+    topgg::async_result<std::unordered_map<dpp::snowflake, bool>> co_has_voted_many(const std::vector<dpp::snowflake>& user_ids);
+#endif
+
+    /**
+     * @brief Sets the policy used to retry requests that failed because of a transient error. Retries are scheduled on D++ timers and never block a thread.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg::retry_policy policy{};
+     * policy.max_attempts = 5;
+     *
+     * topgg_client.set_retry_policy(policy);
+     * ```
+     *
+     * @param policy The retry policy to use.
+     * @throw std::invalid_argument Throws if the policy's max_attempts is zero, or its jitter isn't between 0 and 1.
+     * @note This function must be called before sending any request. The amount of attempts made can be retrieved from topgg::result::attempts.
+     * @note If the client is destroyed while a retry is waiting for its timer, the retry is cancelled and its callback is called right away with the last failed attempt's response.
+     * @see topgg::retry_policy
+     * @see topgg::result::attempts
+     * @since 2.1.0
+     */
+    void set_retry_policy(const retry_policy& policy);
+
+    /**
+     * @brief Enables the built-in rate limiter.
+     *
+     * Requests are throttled with a token bucket per Top.gg route family (100 requests per second globally, 60 requests per minute on the /bots routes).
+     * Requests that would exceed these limits, or that are sent while a retry_after window is active, are queued and sent later from a D++ timer.
+     * A request that still receives a 429 response is queued again once before its error is returned.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.enable_ratelimiter();
+     * ```
+     *
+     * @note This function must be called before sending any request, and has no effect if the rate limiter is already enabled.
+     * @see topgg::client::ratelimiter_stats
+     * @since 2.1.0
+     */
+    void enable_ratelimiter();
+
+    /**
+     * @brief Returns a snapshot of the rate limiter's metrics.
+     *
+     * Example:
+     *
+     * ```cpp
+     * const auto limits = topgg_client.ratelimiter_stats();
+     *
+     * std::cout << limits.queue_depth << " queued, " << limits.total_delay.count() << "ms total delay" << std::endl;
+     * ```
+     *
+     * @return ratelimit_stats A snapshot of the rate limiter's metrics. Every metric is zero if the rate limiter is not enabled.
+     * @see topgg::client::enable_ratelimiter
+     * @since 2.1.0
+     */
+    ratelimit_stats ratelimiter_stats() const noexcept;
+
+    /**
+     * @brief Enables an in-process cache of has_voted results. Cached results are returned without sending any HTTP request.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.enable_vote_cache(120, 600, 50000);
+     * ```
+     *
+     * @param ttl The amount of seconds a negative result is cached for. Defaults to 60 seconds.
+     * @param voted_ttl The amount of seconds a positive result is cached for. A has_voted result doesn't say when the vote was cast, so this should be kept short. Capped to 12 hours, the time it takes before a user can vote again. Defaults to 5 minutes.
+     * @param max_size The maximum amount of users cached at once. The least recently used entry is evicted when it's full. Defaults to 10000.
+     * @throw std::invalid_argument Throws if the max_size argument is zero.
+     * @note This function must be called before sending any request, and has no effect if the cache is already enabled.
+     * @see topgg::client::has_voted
+     * @see topgg::client::cache_vote
+     * @see topgg::client::invalidate_vote
+     * @since 2.1.0
+     */
+    void enable_vote_cache(const time_t ttl = 60, const time_t voted_ttl = 300, const size_t max_size = 10000);
+
+    /**
+     * @brief Manually inserts a user's vote status into the vote cache, for example upon receiving a vote webhook.
+     *
+     * A vote inserted here is taken as just cast, and is cached for the full 12 hours it counts for. A non-vote is cached like a negative has_voted result.
+     *
+     * Example:
+     *
+     * ```cpp
+     * topgg_client.cache_vote(661200758510977084);
+     * ```
+     *
+     * @param user_id The Discord user ID to insert.
+     * @param voted Whether the user has voted. Defaults to true.
+     * @note This function has no effect if the vote cache is not enabled.
+     * @see topgg::client::enable_vote_cache
+     * @since 2.1.0
+     */
+    void cache_vote(const dpp::snowflake user_id, const bool voted = true);
+
+    /**
+     * @brief Removes a user from the vote cache, so the next has_voted call for this user sends an HTTP request.
+     *
+     * Example:
+     *
+     * ```cpp
+     * topgg_client.invalidate_vote(661200758510977084);
+     * ```
+     *
+     * @param user_id The Discord user ID to remove.
+     * @note This function has no effect if the vote cache is not enabled.
+     * @see topgg::client::enable_vote_cache
+     * @since 2.1.0
+     */
+    void invalidate_vote(const dpp::snowflake user_id);
+
     /**
      * @brief Checks if the weekend multiplier is active.
      *
@@ -649,6 +1085,188 @@ namespace topgg {
     dpp::async<bool> co_post_stats(const stats& s);
 #endif
 
+    /**
+     * @brief Replaces the transport every HTTP request is sent through. By default, requests are sent through the D++ cluster's HTTP client.
+     *
+     * Example:
+     *
+     * ```cpp
+     * class my_transport: public topgg::transport {
+     *   // ...
+     * };
+     *
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.set_transport(std::make_shared<my_transport>());
+     * ```
+     *
+     * @param new_transport The new transport to use.
+     * @throw std::invalid_argument Throws if the new_transport argument is null.
+     * @note This function must be called before sending any request.
+     * @see topgg::transport
+     * @see topgg::dpp_transport
+     * @since 2.1.0
+     */
+    void set_transport(const std::shared_ptr<transport>& new_transport);
+
+    /**
+     * @brief Changes the base URL every request path is appended to. Defaults to https://top.gg/api.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * // e.g. a local topgg_mock_server
+     * topgg_client.set_base_url("http://127.0.0.1:8080/api");
+     * ```
+     *
+     * @param base_url The new base URL, without a trailing slash.
+     * @note This function must be called before sending any request.
+     * @since 2.1.0
+     */
+    void set_base_url(const std::string& base_url);
+
+    /**
+     * @brief Changes the maximum size of a response body, in bytes. Defaults to 32 MiB.
+     *
+     * Responses are requested gzip-compressed. A compressed body is inflated in chunks into a buffer reused by the thread parsing it,
+     * and inflating stops as soon as the limit is exceeded, so a response never takes more memory than this limit allows.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.set_max_body_size(4 * 1024 * 1024);
+     * ```
+     *
+     * @param max_body_size The maximum size of a response body, before and after inflating it.
+     * @throw std::invalid_argument Throws if the maximum size is zero.
+     * @note Results whose response body is too large throw topgg::response_too_large when parsed.
+     * @see topgg::response_too_large
+     * @since 2.1.0
+     */
+    void set_max_body_size(const size_t max_body_size);
+
+    /**
+     * @brief Enables recording of request metrics: latency histograms, status code and error counts, in-flight requests and bytes received, per Top.gg API route.
+     *
+     * Every request, including every retry attempt, is recorded with a handful of relaxed atomic operations and no locking.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.enable_metrics();
+     * ```
+     *
+     * @note This function must be called before sending any request, and has no effect if metrics are already enabled.
+     * @see topgg::client::metrics
+     * @since 2.1.0
+     */
+    void enable_metrics();
+
+    /**
+     * @brief Returns a snapshot of the recorded request metrics.
+     *
+     * Example:
+     *
+     * ```cpp
+     * const auto snapshot = topgg_client.metrics();
+     *
+     * for (const auto& endpoint: snapshot.endpoints) {
+     *   std::cout << endpoint.method << " " << endpoint.route << ": " << endpoint.requests << " requests" << std::endl;
+     * }
+     *
+     * // or, for a Prometheus scrape endpoint:
+     * const auto text = snapshot.to_prometheus();
+     * ```
+     *
+     * @return metrics_snapshot A snapshot of the recorded request metrics. It has no endpoints if metrics are not enabled.
+     * @see topgg::client::enable_metrics
+     * @see topgg::metrics_snapshot::to_prometheus
+     * @since 2.1.0
+     */
+    metrics_snapshot metrics() const;
+
+    /**
+     * @brief Enables counting every shard's servers as they are joined and left, instead of walking D++'s guild cache every time statistics are gathered.
+     *
+     * Once enabled, post_stats() without statistics and the autoposter read one atomic counter per shard instead of calling get_guild_count() on every shard.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token", dpp::i_default_intents, 256};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg_client.enable_guild_counting();
+     * topgg_client.start_autoposter();
+     * ```
+     *
+     * @throw std::invalid_argument Throws if the cluster's shard count isn't known yet.
+     * @note This function must be called before starting the autoposter, and has no effect if counting is already enabled.
+     * If your cluster picks its shard count automatically, call this once bot.start(dpp::st_return) has returned, when the shard count is known.
+     * Never call it from an event handler such as on_ready, as attaching to on_ready from within an on_ready handler deadlocks.
+     * @see topgg::guild_counter
+     * @since 2.1.0
+     */
+    void enable_guild_counting();
+
+#ifndef _WIN32
+    /**
+     * @brief Enables merging statistics with other processes running the same bot on the same machine, each owning a different range of shards.
+     *
+     * Every process publishes its own shards' server counts to a Unix domain socket at the given path. A single process becomes the leader,
+     * and its autoposter posts the merged statistics of every process, while the autoposter of every other process doesn't post anything.
+     * Another process takes over if the leader exits.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token", dpp::i_default_intents, total_shards, cluster_id, max_clusters};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * // every process uses the same path
+     * topgg_client.enable_stats_aggregation("/tmp/my-bot-topgg.sock");
+     * topgg_client.start_autoposter();
+     * ```
+     *
+     * @param socket_path The path of the Unix domain socket shared by every process. A lock file is created next to it, with .lock appended.
+     * @param interval The amount of seconds between every update. Defaults to 30 seconds.
+     * @throw std::invalid_argument Throws if the socket path is empty or too long, or if the interval is shorter than 5 seconds.
+     * @throw std::system_error Throws if the socket or its lock file can't be opened.
+     * @note This function must be called before starting the autoposter, and has no effect if aggregation is already enabled. It is not available on Windows.
+     * @see topgg::client::start_autoposter
+     * @see topgg::client::aggregator_stats
+     * @since 2.1.0
+     */
+    void enable_stats_aggregation(const std::string& socket_path, const time_t interval = 30);
+
+    /**
+     * @brief Returns a snapshot of the stats aggregator's state.
+     *
+     * Example:
+     *
+     * ```cpp
+     * const auto aggregation = topgg_client.aggregator_stats();
+     *
+     * std::cout << (aggregation.leader ? "leader" : "follower") << ", " << aggregation.known_shards << " shards known" << std::endl;
+     * ```
+     *
+     * @return aggregation_stats A snapshot of the stats aggregator's state. Every field is zero or false if aggregation is not enabled.
+     * @see topgg::client::enable_stats_aggregation
+     * @since 2.1.0
+     */
+    aggregation_stats aggregator_stats() const noexcept;
+#endif
+
     /**
      * @brief Starts autoposting statistics using data directly from your D++ cluster instance.
      *
@@ -694,6 +1312,81 @@ namespace topgg {
      * @since 2.0.0
      */
     void start_autoposter(const custom_autopost_callback_t& callback, const time_t delay = 1800);
+
+    /**
+     * @brief Starts autoposting statistics using data directly from your D++ cluster instance, as configured by the given options.
+     *
+     * Statistics are only posted if they changed since the last successful post.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg::autopost_options options{};
+     * options.on_guild_events = true;
+     *
+     * topgg_client.start_autoposter(options);
+     * ```
+     *
+     * @param options When to post statistics.
+     * @throw std::invalid_argument Throws if the maximum interval is shorter than 15 minutes, or if on_guild_events is set and the minimum interval is shorter than a minute or longer than the maximum interval.
+     * @note This function has no effect if the autoposter is already running.
+     * @see topgg::autopost_options
+     * @see topgg::client::autoposter_stats
+     * @see topgg::client::stop_autoposter
+     * @since 2.1.0
+     */
+    void start_autoposter(const autopost_options& options);
+
+    /**
+     * @brief Starts autoposting statistics, as configured by the given options.
+     *
+     * Statistics are only posted if they changed since the last successful post.
+     *
+     * Example:
+     *
+     * ```cpp
+     * dpp::cluster bot{"your bot token"};
+     * topgg::client topgg_client{bot, "your top.gg token"};
+     *
+     * topgg::autopost_options options{};
+     * options.on_guild_events = true;
+     * options.min_interval = 600;
+     *
+     * topgg_client.start_autoposter([](dpp::cluster& bot_inner) {
+     *   return topgg::stats{...};
+     * }, options);
+     * ```
+     *
+     * @param callback The callback function that returns the current stats.
+     * @param options When to post statistics.
+     * @throw std::invalid_argument Throws if the maximum interval is shorter than 15 minutes, or if on_guild_events is set and the minimum interval is shorter than a minute or longer than the maximum interval.
+     * @note This function has no effect if the autoposter is already running.
+     * @see topgg::autopost_options
+     * @see topgg::client::autoposter_stats
+     * @see topgg::client::stop_autoposter
+     * @since 2.1.0
+     */
+    void start_autoposter(const custom_autopost_callback_t& callback, const autopost_options& options);
+
+    /**
+     * @brief Returns a snapshot of the autoposter's counters.
+     *
+     * Example:
+     *
+     * ```cpp
+     * const auto autoposter = topgg_client.autoposter_stats();
+     *
+     * std::cout << autoposter.posted << " posted, " << autoposter.skipped << " skipped" << std::endl;
+     * ```
+     *
+     * @return autopost_stats A snapshot of the autoposter's counters. Every counter is zero if the autoposter is not running.
+     * @see topgg::client::start_autoposter
+     * @since 2.1.0
+     */
+    autopost_stats autoposter_stats() const noexcept;
     
     /**
      * @brief Prematurely stops the autoposter. Calling this function is usually unnecessary as this function is called later in the destructor.
@@ -718,8 +1411,13 @@ namespace topgg {
     void stop_autoposter() noexcept;
     
     /**
-     * @brief The destructor. Stops the autoposter if it's running.
+     * @brief The destructor. Stops the autoposter if it's running, and cancels every retry still waiting for its timer.
+     *
+     * The callback of every cancelled retry is called from the destructor with the last failed attempt's response.
      */
     ~client();
+
+    friend class vote_tracker;
+    friend class webhook_server;
   };
 }; // namespace topgg
@@ -0,0 +1,117 @@
+/**
+ * @module topgg
+ * @file counter.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+namespace topgg {
+  class client;
+
+  /**
+   * @brief Keeps a per-shard server count up to date from D++'s guild events, so that statistics can be gathered without walking D++'s guild cache.
+   *
+   * topgg::stats::stats(dpp::cluster&) calls get_guild_count() on every shard, and each call locks D++'s guild cache and goes through every server in it.
+   * This instead reads one atomic counter per shard. Counters are seeded from the guild cache once, then follow server joins and leaves,
+   * and a shard's counter starts over from zero whenever it receives a new READY.
+   *
+   * Example:
+   *
+   * ```cpp
+   * dpp::cluster bot{"your bot token", dpp::i_default_intents, 16};
+   * topgg::guild_counter counter{bot};
+   *
+   * const auto stats = counter.snapshot();
+   * ```
+   *
+   * @note Servers that are temporarily unavailable because of a Discord outage aren't counted until they are available again.
+   * @see topgg::client::enable_guild_counting
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT guild_counter {
+    /**
+     * Every counter has its own cache line, so that shards handled by different D++ threads don't slow each other down.
+     */
+    struct alignas(64) shard_counter {
+      std::atomic_size_t guilds{0};
+    };
+
+    dpp::cluster& m_cluster;
+    uint32_t m_shard_count;
+    std::unique_ptr<shard_counter[]> m_shards;
+    dpp::event_handle m_ready;
+    dpp::event_handle m_guild_create;
+    dpp::event_handle m_guild_delete;
+
+    void added(const uint32_t shard_id) noexcept;
+    void removed(const uint32_t shard_id) noexcept;
+    void reset(const uint32_t shard_id) noexcept;
+
+  public:
+    guild_counter() = delete;
+
+    /**
+     * @brief Starts counting every shard's servers.
+     *
+     * @param cluster The D++ cluster instance. Its shard count must be known, which is the case once it has started or if it was given one explicitly.
+     * @throw std::invalid_argument Throws if the cluster's shard count isn't known yet.
+     * @note This attaches to on_ready, on_guild_create and on_guild_delete, so it mustn't be constructed from within one of their handlers.
+     * @since 2.1.0
+     */
+    guild_counter(dpp::cluster& cluster);
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    guild_counter(const guild_counter& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return guild_counter The current modified object.
+     * @since 2.1.0
+     */
+    guild_counter& operator=(const guild_counter& other) = delete;
+
+    /**
+     * @brief Returns a shard's current server count.
+     *
+     * @param shard_id The shard's ID.
+     * @return size_t The shard's current server count, or zero if it doesn't exist.
+     * @since 2.1.0
+     */
+    size_t server_count(const uint32_t shard_id) const noexcept;
+
+    /**
+     * @brief Returns statistics built from every shard's current server count, without taking any lock.
+     *
+     * Shards that aren't run by this process are reported with zero servers.
+     *
+     * @return stats Statistics built from every shard's current server count.
+     * @since 2.1.0
+     */
+    ::topgg::stats snapshot() const;
+
+    /**
+     * @brief The destructor. Stops following server joins and leaves.
+     */
+    ~guild_counter();
+
+    friend class client;
+  };
+}; // namespace topgg
@@ -0,0 +1,196 @@
+/**
+ * @module topgg
+ * @file metrics.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+
+namespace topgg {
+  /**
+   * @brief The metrics recorded for a single Top.gg API route and HTTP method.
+   *
+   * @see topgg::metrics_snapshot
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT endpoint_metrics {
+    /**
+     * @brief The normalized route, e.g. /bots/:id, /users/:id, /bots/votes, /bots/stats or /weekend.
+     *
+     * @since 2.1.0
+     */
+    std::string route;
+
+    /**
+     * @brief The HTTP method, e.g. GET or POST.
+     *
+     * @since 2.1.0
+     */
+    std::string method;
+
+    /**
+     * @brief The amount of completed requests. Every retry attempt counts as a separate request.
+     *
+     * @since 2.1.0
+     */
+    size_t requests;
+
+    /**
+     * @brief The amount of requests currently waiting for a response.
+     *
+     * @since 2.1.0
+     */
+    size_t in_flight;
+
+    /**
+     * @brief The total size of every response body received.
+     *
+     * @since 2.1.0
+     */
+    size_t bytes_received;
+
+    /**
+     * @brief The total time spent waiting for responses.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::nanoseconds total_latency;
+
+    /**
+     * @brief The amount of requests per latency bucket. The last bucket counts every request slower than the highest bound.
+     *
+     * @see topgg::metrics_snapshot::latency_bounds
+     * @since 2.1.0
+     */
+    std::vector<size_t> latency_buckets;
+
+    /**
+     * @brief The amount of responses received per HTTP status code.
+     *
+     * @since 2.1.0
+     */
+    std::map<uint16_t, size_t> statuses;
+
+    /**
+     * @brief The amount of requests that failed with each D++ HTTP error, without receiving a response.
+     *
+     * @since 2.1.0
+     */
+    std::map<dpp::http_error, size_t> errors;
+  };
+
+  /**
+   * @brief A snapshot of the client's request metrics.
+   *
+   * @see topgg::client::enable_metrics
+   * @see topgg::client::metrics
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT metrics_snapshot {
+    /**
+     * @brief The upper bounds of the latency histogram buckets, shared by every endpoint.
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::chrono::milliseconds> latency_bounds;
+
+    /**
+     * @brief The metrics of every route and method that has sent at least one request.
+     *
+     * @since 2.1.0
+     */
+    std::vector<endpoint_metrics> endpoints;
+
+    /**
+     * @brief Formats this snapshot in the Prometheus text exposition format.
+     *
+     * The following metrics are exported, labeled by route and method:
+     * - topgg_request_duration_seconds (histogram)
+     * - topgg_responses_total (counter, also labeled by status)
+     * - topgg_request_errors_total (counter, also labeled by error)
+     * - topgg_requests_in_flight (gauge)
+     * - topgg_response_bytes_total (counter)
+     *
+     * @return std::string This snapshot in the Prometheus text exposition format.
+     * @since 2.1.0
+     */
+    std::string to_prometheus() const;
+  };
+
+  class client;
+
+  /**
+   * @brief Records request latencies, status codes, errors and response sizes with lock-free counters.
+   *
+   * @see topgg::client::enable_metrics
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT metrics_registry {
+    static constexpr size_t route_count = 6;
+    static constexpr size_t method_count = 2;
+    static constexpr size_t bucket_count = 12;
+    static constexpr size_t status_count = 600;
+    static constexpr size_t error_count = 16;
+
+    struct slot {
+      std::atomic_uint64_t requests{0};
+      std::atomic_uint64_t in_flight{0};
+      std::atomic_uint64_t bytes_received{0};
+      std::atomic_uint64_t total_latency_ns{0};
+      std::array<std::atomic_uint64_t, bucket_count> latency_buckets{};
+      std::array<std::atomic_uint64_t, status_count> statuses{};
+      std::array<std::atomic_uint64_t, error_count> errors{};
+    };
+
+    std::array<slot, route_count * method_count> m_slots;
+
+    metrics_registry() = default;
+
+    static size_t slot_of(const std::string& url, const dpp::http_method method) noexcept;
+
+    size_t begin(const std::string& url, const dpp::http_method method) noexcept;
+    void end(const size_t slot_index, const std::chrono::steady_clock::time_point started_at, const dpp::http_request_completion_t& response) noexcept;
+
+  public:
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    metrics_registry(const metrics_registry& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return metrics_registry The current modified object.
+     * @since 2.1.0
+     */
+    metrics_registry& operator=(const metrics_registry& other) = delete;
+
+    /**
+     * @brief Returns a snapshot of the recorded metrics.
+     *
+     * @return metrics_snapshot A snapshot of the recorded metrics.
+     * @since 2.1.0
+     */
+    metrics_snapshot snapshot() const;
+
+    friend class client;
+  };
+}; // namespace topgg
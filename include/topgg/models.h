@@ -12,10 +12,16 @@
 
 #include <topgg/topgg.h>
 
+#include <string_view>
+#include <functional>
+#include <iterator>
+#include <cstdint>
+#include <array>
 #include <string>
 #include <optional>
 #include <string>
 #include <vector>
+#include <map>
 
 #if !defined(_WIN32) && !defined(_XOPEN_SOURCE)
 #define _XOPEN_SOURCE
@@ -28,6 +34,49 @@
 #endif
 
 namespace topgg {
+  /**
+   * @brief The image format of a Discord avatar URL.
+   *
+   * @see topgg::account::avatar
+   * @see topgg::voter_view::avatar
+   * @since 2.1.0
+   */
+  enum class avatar_format {
+    /**
+     * @brief GIF for animated avatars, PNG otherwise.
+     *
+     * @since 2.1.0
+     */
+    automatic,
+
+    /**
+     * @brief PNG.
+     *
+     * @since 2.1.0
+     */
+    png,
+
+    /**
+     * @brief WebP.
+     *
+     * @since 2.1.0
+     */
+    webp,
+
+    /**
+     * @brief GIF. Only available for animated avatars, PNG is used otherwise.
+     *
+     * @since 2.1.0
+     */
+    gif
+  };
+
+  /**
+   * The compile-time table of JSON fields a model is read from and written to, only defined in models.cpp.
+   */
+  template<typename T>
+  struct model_schema;
+
   /**
    * @brief Base class of the account data stored in the Top.gg API.
    *
@@ -37,8 +86,15 @@ namespace topgg {
    * @since 2.0.0
    */
   class TOPGG_EXPORT account {
+    std::array<uint8_t, 16> m_avatar_hash{};
+    std::string m_raw_avatar_hash;
+    uint8_t m_avatar_flags = 0;
+
+    void set_avatar_hash(const std::optional<std::string_view>& hash);
+
   protected:
     account(const dpp::json& j);
+    account(const dpp::snowflake id_in, std::string&& username_in, const std::optional<std::string_view>& avatar_hash);
 
   public:
     account() = delete;
@@ -51,12 +107,33 @@ namespace topgg {
     dpp::snowflake id;
 
     /**
-     * @brief The account's entire Discord avatar URL.
+     * @brief Builds the account's entire Discord avatar URL.
      *
-     * @note This avatar URL can be animated if possible.
-     * @since 2.0.0
+     * Only the avatar hash is stored, so the URL is built every time this is called.
+     *
+     * @param size The image size. Must be a power of two between 16 and 4096. Defaults to 1024.
+     * @param format The image format. Defaults to GIF for animated avatars and PNG otherwise.
+     * @return std::string The account's entire Discord avatar URL. Accounts without an avatar get their default avatar, which is always a PNG.
+     * @throw std::invalid_argument If the size argument is not a power of two between 16 and 4096.
+     * @since 2.1.0
+     */
+    std::string avatar(const uint16_t size = 1024, const avatar_format format = avatar_format::automatic) const;
+
+    /**
+     * @brief Returns the account's Discord avatar hash, if it has one.
+     *
+     * @return std::optional<std::string> The account's Discord avatar hash, if it has one.
+     * @since 2.1.0
      */
-    std::string avatar;
+    std::optional<std::string> avatar_hash() const;
+
+    /**
+     * @brief Returns true if the account has an animated avatar.
+     *
+     * @return bool Whether the account has an animated avatar.
+     * @since 2.1.0
+     */
+    bool has_animated_avatar() const noexcept;
 
     /**
      * @brief The account's username.
@@ -87,9 +164,200 @@ namespace topgg {
     inline voter(const dpp::json& j)
       : account(j) {}
 
+    inline voter(const dpp::snowflake id_in, std::string&& username_in, const std::optional<std::string_view>& avatar_hash)
+      : account(id_in, std::move(username_in), avatar_hash) {}
+
+    static std::vector<voter> parse_list(const std::string& body);
+    static void scan_list(const std::string& body, const std::function<bool(const dpp::snowflake, std::string&, const std::string*)>& fn);
+
   public:
     voter() = delete;
 
+    friend class client;
+    friend class voter_view;
+    friend class vote_tracker;
+  };
+
+  class voter_list;
+
+  /**
+   * @brief A lightweight, non-owning view of a single voter stored in a voter_list.
+   *
+   * @note This view is only valid for as long as the voter_list it came from.
+   * @see topgg::voter_list
+   * @see topgg::client::get_voter_list
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT voter_view {
+    inline voter_view(const dpp::snowflake id_in, const std::string_view username_in, const std::string_view avatar_hash_in) noexcept
+      : id(id_in), username(username_in), avatar_hash(avatar_hash_in) {}
+
+  public:
+    voter_view() = delete;
+
+    /**
+     * @brief The voter's Discord ID.
+     *
+     * @since 2.1.0
+     */
+    dpp::snowflake id;
+
+    /**
+     * @brief The voter's username.
+     *
+     * @since 2.1.0
+     */
+    std::string_view username;
+
+    /**
+     * @brief The voter's Discord avatar hash. Empty if the voter has no avatar.
+     *
+     * @since 2.1.0
+     */
+    std::string_view avatar_hash;
+
+    /**
+     * @brief Builds the voter's entire Discord avatar URL. Nothing is allocated until this is called.
+     *
+     * @param size The image size. Must be a power of two between 16 and 4096. Defaults to 1024.
+     * @param format The image format. Defaults to GIF for animated avatars and PNG otherwise.
+     * @return std::string The voter's entire Discord avatar URL, the same as topgg::account::avatar.
+     * @throw std::invalid_argument If the size argument is not a power of two between 16 and 4096.
+     * @since 2.1.0
+     */
+    std::string avatar(const uint16_t size = 1024, const avatar_format format = avatar_format::automatic) const;
+
+    /**
+     * @brief Returns the unix timestamp of when this voter's account was created.
+     *
+     * @return time_t The unix timestamp of when this voter's account was created.
+     * @since 2.1.0
+     */
+    time_t created_at() const noexcept;
+
+    /**
+     * @brief Copies this view into an owning voter object.
+     *
+     * @return voter An owning copy of this voter.
+     * @since 2.1.0
+     */
+    voter to_voter() const;
+
+    friend class voter_list;
+  };
+
+  /**
+   * @brief A compact list of voters. Every username and avatar hash is stored in a single shared buffer, so iterating this list doesn't allocate.
+   *
+   * @see topgg::voter_view
+   * @see topgg::client::get_voter_list
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT voter_list {
+    struct entry {
+      dpp::snowflake id;
+      uint32_t username_offset;
+      uint32_t username_length;
+      uint32_t avatar_offset;
+      uint32_t avatar_length;
+    };
+
+    std::string m_buffer;
+    std::vector<entry> m_entries;
+
+    voter_list() = default;
+
+    static voter_list parse(const std::string& body);
+
+  public:
+    /**
+     * @brief Iterates over the voters in a voter_list.
+     *
+     * @since 2.1.0
+     */
+    class iterator {
+      const voter_list* m_list;
+      size_t m_index;
+
+      inline iterator(const voter_list* list, const size_t index) noexcept
+        : m_list(list), m_index(index) {}
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = voter_view;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = voter_view;
+
+      inline voter_view operator*() const noexcept {
+        return (*m_list)[m_index];
+      }
+
+      inline iterator& operator++() noexcept {
+        m_index++;
+
+        return *this;
+      }
+
+      inline iterator operator++(int) noexcept {
+        auto previous = *this;
+        m_index++;
+
+        return previous;
+      }
+
+      inline bool operator==(const iterator& other) const noexcept {
+        return m_list == other.m_list && m_index == other.m_index;
+      }
+
+      inline bool operator!=(const iterator& other) const noexcept {
+        return !(*this == other);
+      }
+
+      friend class voter_list;
+    };
+
+    /**
+     * @brief Returns the amount of voters in this list.
+     *
+     * @return size_t The amount of voters in this list.
+     * @since 2.1.0
+     */
+    inline size_t size() const noexcept {
+      return m_entries.size();
+    }
+
+    /**
+     * @brief Returns true if this list has no voters.
+     *
+     * @return bool Whether this list has no voters.
+     * @since 2.1.0
+     */
+    inline bool empty() const noexcept {
+      return m_entries.empty();
+    }
+
+    /**
+     * @brief Returns a view of the voter at the specified index. The index is not bounds-checked.
+     *
+     * @param index The voter's index in this list.
+     * @return voter_view A view of the voter at the specified index.
+     * @since 2.1.0
+     */
+    inline voter_view operator[](const size_t index) const noexcept {
+      const auto& e = m_entries[index];
+
+      return voter_view{e.id, std::string_view{m_buffer.data() + e.username_offset, e.username_length}, std::string_view{m_buffer.data() + e.avatar_offset, e.avatar_length}};
+    }
+
+    inline iterator begin() const noexcept {
+      return iterator{this, 0};
+    }
+
+    inline iterator end() const noexcept {
+      return iterator{this, m_entries.size()};
+    }
+
     friend class client;
   };
 
@@ -178,7 +446,7 @@ namespace topgg {
     std::optional<std::string> banner;
 
     /**
-     * @brief The unix timestamp of when this Discord bot was approved on Top.gg by a Bot Reviewer.
+     * @brief The UTC unix timestamp of when this Discord bot was approved on Top.gg by a Bot Reviewer.
      *
      * @since 2.0.0
      */
@@ -260,6 +528,7 @@ namespace topgg {
     std::optional<size_t> m_shard_id;
     std::optional<size_t> m_server_count;
 
+    void write_json(std::string& out) const;
     std::string to_json() const;
 
   public:
@@ -324,7 +593,11 @@ namespace topgg {
       m_server_count = std::optional{new_server_count};
     }
 
+    template<typename T>
+    friend struct model_schema;
+
     friend class client;
+    friend class autoposter;
   };
 
   class user;
@@ -376,6 +649,9 @@ namespace topgg {
      */
     std::optional<std::string> youtube;
 
+    template<typename T>
+    friend struct model_schema;
+
     friend class user;
   };
 
@@ -452,4 +728,54 @@ namespace topgg {
 
     friend class client;
   };
+
+  /**
+   * @brief Represents a vote received by a webhook.
+   *
+   * @see topgg::webhook_server
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT vote_event {
+    vote_event(const dpp::json& j);
+
+  public:
+    vote_event() = delete;
+
+    /**
+     * @brief The ID of the Discord bot or server that received the vote.
+     *
+     * @since 2.1.0
+     */
+    dpp::snowflake receiver_id;
+
+    /**
+     * @brief The ID of the Discord user who voted.
+     *
+     * @since 2.1.0
+     */
+    dpp::snowflake voter_id;
+
+    /**
+     * @brief Whether this vote was sent from the Test button on Top.gg's webhook settings page, instead of by a real user.
+     *
+     * @since 2.1.0
+     */
+    bool is_test;
+
+    /**
+     * @brief Whether the weekend multiplier is active, where a single vote counts as two.
+     *
+     * @since 2.1.0
+     */
+    bool is_weekend;
+
+    /**
+     * @brief The query string parameters found on the vote page, already URL-decoded.
+     *
+     * @since 2.1.0
+     */
+    std::map<std::string, std::string> query;
+
+    friend class webhook_server;
+  };
 }; // namespace topgg
\ No newline at end of file
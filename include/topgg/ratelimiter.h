@@ -0,0 +1,150 @@
+/**
+ * @module topgg
+ * @file ratelimiter.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <functional>
+#include <chrono>
+#include <string>
+#include <deque>
+#include <mutex>
+
+namespace topgg {
+  /**
+   * @brief A snapshot of the client's rate limiter metrics.
+   *
+   * @see topgg::client::enable_ratelimiter
+   * @see topgg::client::ratelimiter_stats
+   * @since 2.1.0
+   */
+  struct TOPGG_EXPORT ratelimit_stats {
+    /**
+     * @brief The amount of requests currently waiting to be sent.
+     *
+     * @since 2.1.0
+     */
+    size_t queue_depth;
+
+    /**
+     * @brief The highest amount of requests that have waited to be sent at once.
+     *
+     * @since 2.1.0
+     */
+    size_t max_queue_depth;
+
+    /**
+     * @brief The amount of requests that had to wait before being sent.
+     *
+     * @since 2.1.0
+     */
+    size_t delayed;
+
+    /**
+     * @brief The amount of times Top.gg responded with a 429 Too Many Requests.
+     *
+     * @since 2.1.0
+     */
+    size_t ratelimited;
+
+    /**
+     * @brief The total time spent by requests waiting to be sent.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::milliseconds total_delay;
+
+    /**
+     * @brief The longest time spent by a single request waiting to be sent.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::milliseconds max_delay;
+  };
+
+  class client;
+
+  /**
+   * @brief Throttles requests with a token bucket per Top.gg route family, and holds every request back during retry_after windows.
+   *
+   * @see topgg::client::enable_ratelimiter
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT ratelimiter {
+    struct bucket {
+      double tokens;
+      double capacity;
+      double refill_rate;
+      std::chrono::steady_clock::time_point last_refill;
+
+      bucket(const double capacity_in, const double period_in_seconds);
+
+      bool available(const std::chrono::steady_clock::time_point now) noexcept;
+    };
+
+    struct queued_request {
+      bool is_bots_route;
+      std::function<void()> send;
+      std::chrono::steady_clock::time_point queued_at;
+    };
+
+    std::mutex m_mutex;
+    dpp::cluster& m_cluster;
+    dpp::timer m_timer;
+    bucket m_global;
+    bucket m_bots;
+    std::chrono::steady_clock::time_point m_blocked_until;
+    std::deque<queued_request> m_queue;
+    ratelimit_stats m_stats;
+
+    ratelimiter(dpp::cluster& cluster);
+
+    bool try_acquire(const bool is_bots_route, const std::chrono::steady_clock::time_point now) noexcept;
+    void schedule(const std::string& url, std::function<void()>&& send);
+    void block(const uint16_t retry_after);
+    void drain();
+
+  public:
+    ratelimiter() = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    ratelimiter(const ratelimiter& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return ratelimiter The current modified object.
+     * @since 2.1.0
+     */
+    ratelimiter& operator=(const ratelimiter& other) = delete;
+
+    /**
+     * @brief Returns a snapshot of this rate limiter's metrics.
+     *
+     * @return ratelimit_stats A snapshot of this rate limiter's metrics.
+     * @since 2.1.0
+     */
+    ratelimit_stats stats() noexcept;
+
+    /**
+     * @brief The destructor. Stops the scheduler's timer.
+     */
+    ~ratelimiter();
+
+    friend class client;
+  };
+}; // namespace topgg
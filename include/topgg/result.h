@@ -14,8 +14,13 @@
 
 #include <functional>
 #include <stdexcept>
+#include <exception>
+#include <optional>
 #include <variant>
 #include <utility>
+#include <string>
+#include <memory>
+#include <mutex>
 
 namespace topgg {
   class internal_result;
@@ -77,21 +82,63 @@ namespace topgg {
 
     friend class internal_result;
   };
+
+  /**
+   * @brief An exception that gets thrown when a response body is larger than the client's maximum body size.
+   *
+   * @see topgg::client::set_max_body_size
+   * @since 2.1.0
+   */
+  class response_too_large: public std::runtime_error {
+    inline response_too_large(const size_t max_size_in)
+      : std::runtime_error("The response body exceeds the maximum body size of " + std::to_string(max_size_in) + " bytes."), max_size(max_size_in) {}
+
+  public:
+    /**
+     * @brief The maximum body size that was exceeded, in bytes.
+     *
+     * @since 2.1.0
+     */
+    const size_t max_size;
+
+    response_too_large() = delete;
+
+    friend class internal_result;
+  };
   
   template<typename T>
   class result;
 
   class TOPGG_EXPORT internal_result {
     const dpp::http_request_completion_t m_response;
+    const size_t m_attempts;
+    const size_t m_max_body_size;
 
     void prepare() const;
 
-    inline internal_result(const dpp::http_request_completion_t& response)
-      : m_response(response) {}
+    inline const std::string& body() const {
+      return decode(m_response.body, m_max_body_size);
+    }
+
+    inline internal_result(const dpp::http_request_completion_t& response, const size_t attempts, const size_t max_body_size)
+      : m_response(response), m_attempts(attempts), m_max_body_size(max_body_size) {}
 
   public:
     internal_result() = delete;
 
+    /**
+     * @brief Returns a response body as is, or inflated into a buffer owned by the calling thread if it's gzip-compressed.
+     * The returned reference is only valid until the calling thread decodes another body.
+     *
+     * @param body The response body.
+     * @param max_size The maximum size of the body, before and after inflating it.
+     * @throw topgg::response_too_large Thrown when the body is larger than max_size. Inflating stops as soon as it is.
+     * @throw topgg::internal_server_error Thrown when the body can't be inflated.
+     * @return const std::string& The decoded response body.
+     * @since 2.1.0
+     */
+    static const std::string& decode(const std::string& body, const size_t max_size);
+
     template<typename T>
     friend class result;
   };
@@ -107,33 +154,82 @@ namespace topgg {
    */
   template<typename T>
   class TOPGG_EXPORT result {
+    /**
+     * The parsed data (or the error thrown while parsing it) is shared between every copy of this result,
+     * so the response body is parsed at most once no matter how many times or by how many consumers get() is called.
+     */
+    struct parsed {
+      std::once_flag once;
+      std::optional<T> value;
+      std::exception_ptr error;
+    };
+
     const internal_result m_internal;
-    const std::function<T(const dpp::json& json)> m_parse_fn;
+    const std::function<T(const std::string& body)> m_parse_fn;
+    const std::shared_ptr<parsed> m_parsed;
 
-    inline result(const dpp::http_request_completion_t& response, const std::function<T(const dpp::json&)>& parse_fn)
-      : m_internal(response), m_parse_fn(parse_fn) {}
+    inline result(const dpp::http_request_completion_t& response, const std::function<T(const std::string&)>& parse_fn, const size_t attempts, const size_t max_body_size)
+      : m_internal(response, attempts, max_body_size), m_parse_fn(parse_fn), m_parsed(std::make_shared<parsed>()) {}
+
+    inline result(const T& value)
+      : m_internal(dpp::http_request_completion_t{}, 0, 0), m_parsed(std::make_shared<parsed>()) {
+      std::call_once(m_parsed->once, [this, &value]() {
+        m_parsed->value.emplace(value);
+      });
+    }
+
+    inline result(const std::exception_ptr& error)
+      : m_internal(dpp::http_request_completion_t{}, 0, 0), m_parsed(std::make_shared<parsed>()) {
+      std::call_once(m_parsed->once, [this, &error]() {
+        m_parsed->error = error;
+      });
+    }
 
   public:
     result() = delete;
 
     /**
-     * @brief Tries to retrieve the returned data inside.
+     * @brief Tries to retrieve the returned data inside. The response is only parsed on the first call, later calls return the same data or rethrow the same error.
      *
      * @throw topgg::internal_server_error Thrown when the client receives an unexpected error from Top.gg's end.
      * @throw topgg::invalid_token Thrown when its known that the client uses an invalid Top.gg API token.
      * @throw topgg::not_found Thrown when such query does not exist.
      * @throw topgg::ratelimited Thrown when the client gets ratelimited from sending more HTTP requests.
+     * @throw topgg::response_too_large Thrown when the response body is larger than the client's maximum body size.
      * @throw dpp::http_error Thrown when an unexpected HTTP exception occured.
-     * @return T The desired data, if successful.
+     * @return const T& The desired data, if successful.
      * @since 2.0.0
      */
-    T get() const {
-      m_internal.prepare();
+    const T& get() const {
+      std::call_once(m_parsed->once, [this]() {
+        try {
+          m_internal.prepare();
+          m_parsed->value.emplace(m_parse_fn(m_internal.body()));
+        } catch (...) {
+          m_parsed->error = std::current_exception();
+        }
+      });
 
-      return m_parse_fn(dpp::json::parse(m_internal.m_response.body));
+      if (m_parsed->error) {
+        std::rethrow_exception(m_parsed->error);
+      }
+
+      return m_parsed->value.value();
+    }
+
+    /**
+     * @brief Returns the amount of HTTP requests sent to retrieve this result, including retries.
+     *
+     * @return size_t The amount of HTTP requests sent to retrieve this result. Zero if this result didn't require any HTTP request, e.g. when it comes from a cache.
+     * @see topgg::client::set_retry_policy
+     * @since 2.1.0
+     */
+    inline size_t attempts() const noexcept {
+      return m_internal.m_attempts;
     }
 
     friend class client;
+    friend class vote_tracker;
   };
 
 #ifdef DPP_CORO
@@ -196,11 +292,11 @@ namespace topgg {
      * @throw topgg::not_found Thrown when such query does not exist.
      * @throw topgg::ratelimited Thrown when the client gets ratelimited from sending more HTTP requests.
      * @throw dpp::http_error Thrown when an unexpected HTTP exception occured.
-     * @return T The desired data, if successful.
+     * @return const T& The desired data, if successful.
      * @see topgg::result::get
      * @since 2.0.0
      */
-    inline T& operator co_await() & {
+    inline const T& operator co_await() & {
       return m_fut.operator co_await().get();
     }
     
@@ -212,7 +308,7 @@ namespace topgg {
      * @throw topgg::not_found Thrown when such query does not exist.
      * @throw topgg::ratelimited Thrown when the client gets ratelimited from sending more HTTP requests.
      * @throw dpp::http_error Thrown when an unexpected HTTP exception occured.
-     * @return T The desired data, if successful.
+     * @return const T& The desired data, if successful.
      * @see topgg::result::get
      * @since 2.0.0
      */
@@ -232,7 +328,7 @@ namespace topgg {
      * @see topgg::result::get
      * @since 2.0.0
      */
-    inline T&& operator co_await() && {
+    inline T operator co_await() && {
       return std::forward<dpp::async<result<T>>>(m_fut).operator co_await().get();
     }
     
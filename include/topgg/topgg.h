@@ -49,5 +49,14 @@
 #endif
 
 #include <topgg/result.h>
+#include <topgg/transport.h>
+#include <topgg/cache.h>
+#include <topgg/ratelimiter.h>
+#include <topgg/metrics.h>
 #include <topgg/models.h>
-#include <topgg/client.h>
\ No newline at end of file
+#include <topgg/counter.h>
+#include <topgg/autoposter.h>
+#include <topgg/aggregator.h>
+#include <topgg/client.h>
+#include <topgg/tracker.h>
+#include <topgg/webhook.h>
\ No newline at end of file
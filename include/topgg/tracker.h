@@ -0,0 +1,146 @@
+/**
+ * @module topgg
+ * @file tracker.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <memory>
+#include <deque>
+#include <mutex>
+
+namespace topgg {
+  /**
+   * @brief The callback function to call with newly seen voters.
+   *
+   * @see topgg::vote_tracker
+   * @since 2.1.0
+   */
+  using vote_tracker_callback_t = std::function<void(const std::vector<voter>&)>;
+
+  /**
+   * @brief Polls your Discord bot's voters on a D++ timer, and calls a callback only with voters that haven't been seen before.
+   *
+   * Top.gg lists voters newest first, so every poll only reads the response up to where the previous poll's newest voters begin.
+   * The rest of the response isn't parsed, which makes a poll's cost scale with the amount of new votes instead of the length of the list.
+   *
+   * Seen voters are remembered for 12 hours, the time it takes before a user can vote again, and a user who votes again after that is reported again.
+   *
+   * Example:
+   *
+   * ```cpp
+   * dpp::cluster bot{"your bot token"};
+   * topgg::client topgg_client{bot, "your top.gg token"};
+   *
+   * topgg::vote_tracker tracker{topgg_client, [](const auto& new_voters) {
+   *   for (const auto& voter: new_voters) {
+   *     std::cout << voter.username << " just voted!" << std::endl;
+   *   }
+   * }};
+   * ```
+   *
+   * @note The first poll only records the current voters, without reporting them.
+   * @note The tracker uses the client's settings (transport, rate limiter, retry policy, ...) as they were when the tracker was constructed.
+   * It doesn't hold a reference to the client, so it keeps polling even if the client is destroyed first. Only the D++ cluster must outlive it.
+   * @see topgg::client::get_voters
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT vote_tracker {
+    struct delta {
+      std::vector<voter> voters;
+      size_t scanned;
+    };
+
+    struct state {
+      std::mutex mutex;
+      vote_tracker_callback_t callback;
+      size_t max_seen;
+      bool running;
+      bool polling;
+      bool seeded;
+      std::vector<dpp::snowflake> head;
+      std::unordered_map<dpp::snowflake, time_t> seen;
+      std::deque<std::pair<dpp::snowflake, time_t>> seen_order;
+
+      delta scan(const std::string& body);
+      bool remember(const dpp::snowflake id, const time_t now);
+      void expire(const time_t now);
+    };
+
+    /**
+     * Polls go through the client's request context instead of the client itself, so the tracker may outlive the client.
+     */
+    std::shared_ptr<const client::request_context> m_context;
+    dpp::timer m_timer;
+    std::shared_ptr<state> m_state;
+
+  public:
+    vote_tracker() = delete;
+
+    /**
+     * @brief Starts polling your Discord bot's voters.
+     *
+     * @param topgg_client The client to poll with.
+     * @param callback The callback function to call with newly seen voters, in the order Top.gg lists them.
+     * @param interval The amount of seconds between every poll. Defaults to 60 seconds.
+     * @param max_seen The maximum amount of voters remembered at once. The oldest ones are forgotten first. Defaults to 10000.
+     * @throw std::invalid_argument Throws if the interval is shorter than 15 seconds, or max_seen is zero.
+     * @since 2.1.0
+     */
+    vote_tracker(client& topgg_client, const vote_tracker_callback_t& callback, const time_t interval = 60, const size_t max_seen = 10000);
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    vote_tracker(const vote_tracker& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return vote_tracker The current modified object.
+     * @since 2.1.0
+     */
+    vote_tracker& operator=(const vote_tracker& other) = delete;
+
+    /**
+     * @brief Polls immediately, without waiting for the timer. Does nothing if a poll is already in progress.
+     *
+     * @since 2.1.0
+     */
+    void poll();
+
+    /**
+     * @brief Returns the amount of voters currently remembered.
+     *
+     * @return size_t The amount of voters currently remembered.
+     * @since 2.1.0
+     */
+    size_t size() const;
+
+    /**
+     * @brief Stops polling. Polls still in progress complete without calling the callback.
+     *
+     * @since 2.1.0
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief The destructor. Stops polling.
+     */
+    ~vote_tracker();
+  };
+}; // namespace topgg
@@ -0,0 +1,80 @@
+/**
+ * @module topgg
+ * @file transport.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <string>
+#include <map>
+
+namespace topgg {
+  /**
+   * @brief The interface every HTTP request sent by the client goes through.
+   * Implement this to route requests somewhere else than D++'s HTTP client, e.g. an in-process fake for testing or benchmarking.
+   *
+   * @see topgg::dpp_transport
+   * @see topgg::client::set_transport
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT transport {
+  public:
+    /**
+     * @brief Sends an HTTP request.
+     *
+     * @param url The full URL to send the request to.
+     * @param method The HTTP method to use.
+     * @param body The request body, empty for GET requests.
+     * @param headers The request headers.
+     * @param callback The callback function to call with the response. It must be called exactly once, from any thread.
+     * @since 2.1.0
+     */
+    virtual void request(const std::string& url, const dpp::http_method method, const std::string& body, const std::multimap<std::string, std::string>& headers, dpp::http_completion_event&& callback) = 0;
+
+    /**
+     * @brief The destructor.
+     */
+    virtual ~transport() = default;
+  };
+
+  /**
+   * @brief The default transport, which sends requests through the D++ cluster's HTTP client.
+   *
+   * @see topgg::transport
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT dpp_transport: public transport {
+    dpp::cluster& m_cluster;
+
+  public:
+    dpp_transport() = delete;
+
+    /**
+     * @brief Constructs the D++ transport.
+     *
+     * @param cluster The D++ cluster whose HTTP client is used.
+     * @since 2.1.0
+     */
+    inline dpp_transport(dpp::cluster& cluster)
+      : m_cluster(cluster) {}
+
+    /**
+     * @brief Sends an HTTP request through dpp::cluster::request.
+     *
+     * @param url The full URL to send the request to.
+     * @param method The HTTP method to use.
+     * @param body The request body, empty for GET requests.
+     * @param headers The request headers.
+     * @param callback The callback function to call with the response.
+     * @since 2.1.0
+     */
+    void request(const std::string& url, const dpp::http_method method, const std::string& body, const std::multimap<std::string, std::string>& headers, dpp::http_completion_event&& callback) override;
+  };
+}; // namespace topgg
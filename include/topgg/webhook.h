@@ -0,0 +1,163 @@
+/**
+ * @module topgg
+ * @file webhook.h
+ * @brief The official C++ wrapper for the Top.gg API.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#ifdef __linux__
+
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace topgg {
+  /**
+   * @brief The callback function to call with every vote received by a webhook.
+   *
+   * @see topgg::webhook_server
+   * @since 2.1.0
+   */
+  using vote_event_callback_t = std::function<void(const vote_event&)>;
+
+  class client;
+
+  /**
+   * @brief A small HTTP server that receives vote webhooks from Top.gg, without needing a separate web framework.
+   *
+   * Requests are read on a single epoll thread. Every request must carry the webhook's secret in its Authorization header, otherwise it's rejected with 401 Unauthorized.
+   * A connection that doesn't complete a request within the timeout, whether it sends nothing or trickles it in, is closed so it can't hold one of the server's connection slots forever.
+   * Accepted requests are answered with 204 No Content before the callback is called, so a slow callback never delays Top.gg's request.
+   *
+   * Example:
+   *
+   * ```cpp
+   * dpp::cluster bot{"your bot token"};
+   * topgg::client topgg_client{bot, "your top.gg token"};
+   *
+   * topgg::webhook_server webhook{topgg_client, 8080, "your webhook secret", [](const auto& vote) {
+   *   std::cout << vote.voter_id << " just voted!" << std::endl;
+   * }};
+   * ```
+   *
+   * @note This class is only available on Linux. The server speaks plain HTTP, so put it behind a TLS-terminating reverse proxy if it's reachable from the internet.
+   * @see topgg::vote_event
+   * @since 2.1.0
+   */
+  class TOPGG_EXPORT webhook_server {
+    /**
+     * A connection is closed once its deadline passes. Only a complete request pushes the deadline back, receiving part of one doesn't.
+     */
+    struct connection {
+      std::string buffer;
+      std::chrono::steady_clock::time_point deadline;
+    };
+
+    dpp::cluster& m_cluster;
+    client* m_client;
+    std::string m_authorization;
+    vote_event_callback_t m_callback;
+    int m_socket;
+    int m_epoll;
+    int m_wakeup;
+    uint16_t m_port;
+    std::chrono::seconds m_timeout;
+    std::unordered_map<int, connection> m_connections;
+    std::thread m_thread;
+
+    webhook_server(dpp::cluster& cluster, client* topgg_client, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address, const time_t timeout);
+
+    void run();
+    void accept_connections();
+    bool receive(const int fd, connection& conn);
+    void dispatch(vote_event&& event);
+    void close_connection(const int fd) noexcept;
+    void close_stale_connections() noexcept;
+    void close_sockets() noexcept;
+
+  public:
+    webhook_server() = delete;
+
+    /**
+     * @brief Starts listening for vote webhooks.
+     *
+     * @param cluster The D++ cluster whose thread pool the callback is called on.
+     * @param port The port to listen on. Zero picks any free port, see port().
+     * @param authorization The webhook secret set on Top.gg's webhook settings page.
+     * @param callback The callback function to call with every vote received.
+     * @param address The IPv4 address to listen on. Defaults to every address.
+     * @param timeout The amount of seconds a connection has to complete a request, counted from when it's opened or its previous request was answered. Defaults to 10 seconds.
+     * @throw std::invalid_argument Throws if the authorization argument is empty, or the timeout isn't positive.
+     * @throw std::system_error Throws if the socket can't be created, bound or listened on.
+     * @since 2.1.0
+     */
+    webhook_server(dpp::cluster& cluster, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address = "0.0.0.0", const time_t timeout = 10);
+
+    /**
+     * @brief Starts listening for vote webhooks, and inserts every voter into the client's vote cache before calling the callback.
+     *
+     * @param topgg_client The client whose vote cache is updated. Must outlive this object.
+     * @param port The port to listen on. Zero picks any free port, see port().
+     * @param authorization The webhook secret set on Top.gg's webhook settings page.
+     * @param callback The callback function to call with every vote received.
+     * @param address The IPv4 address to listen on. Defaults to every address.
+     * @param timeout The amount of seconds a connection has to complete a request, counted from when it's opened or its previous request was answered. Defaults to 10 seconds.
+     * @throw std::invalid_argument Throws if the authorization argument is empty, or the timeout isn't positive.
+     * @throw std::system_error Throws if the socket can't be created, bound or listened on.
+     * @see topgg::client::enable_vote_cache
+     * @see topgg::client::cache_vote
+     * @since 2.1.0
+     */
+    webhook_server(client& topgg_client, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address = "0.0.0.0", const time_t timeout = 10);
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @since 2.1.0
+     */
+    webhook_server(const webhook_server& other) = delete;
+
+    /**
+     * @brief This object can't be copied.
+     *
+     * @param other Other object to copy from.
+     * @return webhook_server The current modified object.
+     * @since 2.1.0
+     */
+    webhook_server& operator=(const webhook_server& other) = delete;
+
+    /**
+     * @brief Returns the port this server is listening on.
+     *
+     * @return uint16_t The port this server is listening on.
+     * @since 2.1.0
+     */
+    uint16_t port() const noexcept;
+
+    /**
+     * @brief Stops listening and closes every open connection. Callbacks already dispatched still run.
+     *
+     * @since 2.1.0
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief The destructor. Stops listening.
+     */
+    ~webhook_server();
+  };
+}; // namespace topgg
+
+#endif
@@ -0,0 +1,361 @@
+#include <topgg/topgg.h>
+
+#ifndef _WIN32
+
+#include <system_error>
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+using topgg::aggregation_stats;
+using topgg::stats_aggregator;
+
+using std::chrono::steady_clock;
+
+/**
+ * Every update is a single datagram: the header, the total amount of shards, then a shard_id:server_count pair for every local shard.
+ */
+static constexpr std::string_view update_header = "topgg-stats 1 ";
+
+/**
+ * Shards that haven't been updated for this many intervals belong to a process that exited, and are left out of the merged statistics.
+ */
+static constexpr int stale_intervals = 3;
+
+/**
+ * Updates claiming more shards than this are rejected, as the merged statistics hold a server count for every shard.
+ * It's far above what any bot runs.
+ */
+static constexpr size_t max_shard_count = 65536;
+
+static sockaddr_un address_of(const std::string& path) noexcept {
+  sockaddr_un address{};
+
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  return address;
+}
+
+/**
+ * SOCK_NONBLOCK and SOCK_CLOEXEC are Linux-only, fcntl works on every POSIX system.
+ */
+static int open_socket() noexcept {
+  const auto fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+
+  if (fd >= 0) {
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
+
+  return fd;
+}
+
+/**
+ * Returns a datagram's full length even if it didn't fit in the buffer, so that truncated updates can be told apart.
+ * MSG_TRUNC does that for recv on Linux only, elsewhere truncation is reported through recvmsg's flags instead.
+ */
+static ssize_t receive_datagram(const int fd, char* buffer, const size_t size) noexcept {
+#ifdef __linux__
+  return ::recv(fd, buffer, size, MSG_TRUNC);
+#else
+  iovec io{buffer, size};
+  msghdr message{};
+
+  message.msg_iov = &io;
+  message.msg_iovlen = 1;
+
+  const auto received = ::recvmsg(fd, &message, 0);
+
+  if (received >= 0 && (message.msg_flags & MSG_TRUNC) != 0) {
+    return static_cast<ssize_t>(size) + 1;
+  }
+
+  return received;
+#endif
+}
+
+static bool parse_number(std::string_view& input, size_t& value) noexcept {
+  const auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value);
+
+  if (ec != std::errc{} || end == input.data()) {
+    return false;
+  }
+
+  input.remove_prefix(static_cast<size_t>(end - input.data()));
+
+  return true;
+}
+
+stats_aggregator::stats_aggregator(dpp::cluster& cluster, const std::string& path, const time_t interval)
+  : m_cluster(cluster), m_path(path), m_interval(interval), m_timer(0), m_lock(-1), m_socket(-1), m_leader(false), m_changed(false), m_shard_count(0), m_buffer(262144), m_received(0), m_malformed(0) {
+  if (path.empty() || path.size() >= sizeof(sockaddr_un::sun_path)) {
+    throw std::invalid_argument{"Socket path must be between 1 and " + std::to_string(sizeof(sockaddr_un::sun_path) - 1) + " characters long."};
+  } else if (interval < 5) {
+    throw std::invalid_argument{"Interval mustn't be shorter than 5 seconds."};
+  }
+
+  m_lock = ::open((path + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  m_socket = open_socket();
+
+  if (m_lock < 0 || m_socket < 0) {
+    const auto error = errno;
+
+    if (m_lock >= 0) {
+      ::close(m_lock);
+    }
+
+    if (m_socket >= 0) {
+      ::close(m_socket);
+    }
+
+    throw std::system_error{error, std::generic_category(), "Couldn't open the stats aggregation socket"};
+  }
+
+  update();
+
+  m_timer = m_cluster.start_timer([this](TOPGG_UNUSED dpp::timer) {
+    update();
+  }, static_cast<uint64_t>(interval));
+}
+
+/**
+ * The first process to lock the lock file owns the socket path. A leftover socket from a leader that exited is replaced.
+ */
+bool stats_aggregator::try_lead() {
+  if (::flock(m_lock, LOCK_EX | LOCK_NB) != 0) {
+    return false;
+  }
+
+  const auto leader_socket = open_socket();
+  const auto address = address_of(m_path);
+
+  ::unlink(m_path.c_str());
+
+  /**
+   * Only processes running as the same user may publish updates. bind creates the socket file with the umask applied,
+   * so it's created as 0600 from the start instead of being tightened after another user could have connected to it.
+   * The umask is process-wide, it's only changed for the duration of this call.
+   */
+  auto bound = false;
+
+  if (leader_socket >= 0) {
+    const auto previous_umask = ::umask(0177);
+
+    bound = ::bind(leader_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+
+    ::umask(previous_umask);
+  }
+
+  if (!bound) {
+    if (leader_socket >= 0) {
+      ::close(leader_socket);
+    }
+
+    ::flock(m_lock, LOCK_UN);
+
+    return false;
+  }
+
+  ::close(m_socket);
+  m_socket = leader_socket;
+
+  return true;
+}
+
+std::string stats_aggregator::local_update() const {
+  std::string update{update_header};
+
+  update.append(std::to_string(m_cluster.numshards));
+
+  for (auto& s: m_cluster.get_shards()) {
+    update.push_back(' ');
+    update.append(std::to_string(s.first));
+    update.push_back(':');
+    update.append(std::to_string(s.second->get_guild_count()));
+  }
+
+  return update;
+}
+
+/**
+ * Applies an update only if all of it is well-formed.
+ */
+bool stats_aggregator::merge(std::string_view update, const steady_clock::time_point now) {
+  size_t shard_count = 0;
+
+  if (update.substr(0, update_header.size()) != update_header) {
+    return false;
+  }
+
+  update.remove_prefix(update_header.size());
+
+  if (!parse_number(update, shard_count) || shard_count == 0 || shard_count > max_shard_count) {
+    return false;
+  }
+
+  std::vector<std::pair<uint32_t, size_t>> counts{};
+
+  while (!update.empty()) {
+    size_t shard_id = 0;
+    size_t server_count = 0;
+
+    if (update.front() != ' ') {
+      return false;
+    }
+
+    update.remove_prefix(1);
+
+    if (!parse_number(update, shard_id) || shard_id >= shard_count || update.empty() || update.front() != ':') {
+      return false;
+    }
+
+    update.remove_prefix(1);
+
+    if (!parse_number(update, server_count)) {
+      return false;
+    }
+
+    counts.push_back(std::pair{static_cast<uint32_t>(shard_id), server_count});
+  }
+
+  m_changed |= m_shard_count != shard_count;
+  m_shard_count = static_cast<uint32_t>(shard_count);
+
+  for (const auto& [shard_id, server_count]: counts) {
+    const auto existing = m_shards.find(shard_id);
+
+    if (existing == m_shards.end()) {
+      m_shards.insert(std::pair{shard_id, shard_entry{server_count, now}});
+      m_changed = true;
+    } else {
+      m_changed |= existing->second.server_count != server_count;
+      existing->second = shard_entry{server_count, now};
+    }
+  }
+
+  return true;
+}
+
+void stats_aggregator::receive(const steady_clock::time_point now) {
+  while (true) {
+    const auto received = receive_datagram(m_socket, m_buffer.data(), m_buffer.size());
+
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return;
+    }
+
+    m_received++;
+
+    if (static_cast<size_t>(received) > m_buffer.size() || !merge(std::string_view{m_buffer.data(), static_cast<size_t>(received)}, now)) {
+      m_malformed++;
+    }
+  }
+}
+
+/**
+ * Updates sent while there is no leader are lost, which is fine since every process publishes again on its next update.
+ */
+void stats_aggregator::publish(const std::string& update) const noexcept {
+  const auto address = address_of(m_path);
+
+  ::sendto(m_socket, update.data(), update.size(), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+}
+
+void stats_aggregator::update() {
+  const auto update = local_update();
+
+  std::lock_guard lock{m_mutex};
+
+  if (!m_leader) {
+    m_leader = try_lead();
+  }
+
+  if (m_leader) {
+    const auto now = steady_clock::now();
+
+    merge(update, now);
+    receive(now);
+  } else {
+    publish(update);
+  }
+}
+
+bool stats_aggregator::is_leader() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  return m_leader;
+}
+
+/**
+ * Returns whether any server count changed since the last call.
+ */
+bool stats_aggregator::take_changed() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  const auto changed = m_changed;
+  m_changed = false;
+
+  return changed;
+}
+
+topgg::stats stats_aggregator::merged() {
+  {
+    std::lock_guard lock{m_mutex};
+
+    const auto now = steady_clock::now();
+    std::vector<size_t> shards(m_shard_count, 0);
+    bool any = false;
+
+    for (auto it = m_shards.begin(); it != m_shards.end();) {
+      if (it->first >= m_shard_count || now - it->second.updated_at > m_interval * stale_intervals) {
+        it = m_shards.erase(it);
+        continue;
+      }
+
+      shards[it->first] = it->second.server_count;
+      any = true;
+      it++;
+    }
+
+    if (any) {
+      return ::topgg::stats{shards};
+    }
+  }
+
+  return ::topgg::stats{m_cluster};
+}
+
+aggregation_stats stats_aggregator::stats() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  return aggregation_stats{m_leader, m_leader ? m_shards.size() : 0, m_received, m_malformed};
+}
+
+stats_aggregator::~stats_aggregator() {
+  if (m_timer) {
+    m_cluster.stop_timer(m_timer);
+  }
+
+  if (m_leader) {
+    ::unlink(m_path.c_str());
+  }
+
+  ::close(m_socket);
+  ::close(m_lock);
+}
+
+#endif
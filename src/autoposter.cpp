@@ -0,0 +1,181 @@
+#include <topgg/topgg.h>
+
+#include <stdexcept>
+#include <string>
+
+using topgg::autopost_stats;
+using topgg::autoposter;
+
+using std::chrono::steady_clock;
+
+/**
+ * How often the autoposter checks whether a post is due. Every server join or leave within this window ends up in the same post.
+ */
+static constexpr time_t tick_seconds = 10;
+
+autoposter::autoposter(dpp::cluster& cluster, const std::function<::topgg::stats(dpp::cluster&)>& callback, const autopost_options& options)
+  : m_cluster(cluster), m_callback(callback), m_options(options), m_guild_create(0), m_guild_delete(0), m_dirty(false), m_posting(false), m_last_attempt(steady_clock::now()), m_stats() {
+  if (m_options.on_guild_events) {
+    m_guild_create = m_cluster.on_guild_create.attach([this](TOPGG_UNUSED const dpp::guild_create_t& event) {
+      m_dirty.store(true, std::memory_order_relaxed);
+    });
+
+    m_guild_delete = m_cluster.on_guild_delete.attach([this](TOPGG_UNUSED const dpp::guild_delete_t& event) {
+      m_dirty.store(true, std::memory_order_relaxed);
+    });
+  }
+}
+
+time_t autoposter::tick_interval() const noexcept {
+  return tick_seconds;
+}
+
+/**
+ * Returns the serialized statistics and their hash if a post is due and they changed since the last successful post.
+ * The caller must call complete() afterwards.
+ */
+std::optional<std::pair<std::string, size_t>> autoposter::next() {
+  {
+    std::lock_guard lock{m_mutex};
+
+    if (m_posting) {
+      return std::nullopt;
+    }
+
+    const auto now = steady_clock::now();
+    const auto since = now - m_last_attempt;
+    auto due = since >= std::chrono::seconds{m_options.max_interval};
+
+    /**
+     * A ratelimited post is due as soon as its retry_after window ends, and not a moment earlier.
+     */
+    if (m_retry_at.has_value()) {
+      due = now >= m_retry_at.value();
+    } else if (m_options.on_guild_events && m_dirty.load(std::memory_order_relaxed)) {
+      due = due || since >= std::chrono::seconds{m_options.min_interval};
+    }
+
+    if (!due) {
+      return std::nullopt;
+    }
+
+    m_dirty.store(false, std::memory_order_relaxed);
+    m_retry_at.reset();
+    m_last_attempt = now;
+    m_posting = true;
+  }
+
+  /**
+   * The callback is called without holding the lock, it may take a while to gather statistics.
+   * m_body is only touched by the one next() call in progress, and keeps its capacity so that unchanged statistics are skipped without allocating.
+   */
+  try {
+    m_callback(m_cluster).write_json(m_body);
+  } catch (const std::exception& ex) {
+    failed(std::string{"Gathering statistics failed: "} + ex.what());
+
+    return std::nullopt;
+  } catch (...) {
+    failed("Gathering statistics failed.");
+
+    return std::nullopt;
+  }
+
+  const auto hash = std::hash<std::string>{}(m_body);
+
+  std::lock_guard lock{m_mutex};
+
+  if (m_last_hash == hash) {
+    m_posting = false;
+    m_stats.skipped++;
+
+    return std::nullopt;
+  }
+
+  return std::optional{std::pair{m_body, hash}};
+}
+
+/**
+ * Counts a post that couldn't even be sent because the statistics callback threw. It's tried again on the next tick that is due.
+ */
+void autoposter::failed(std::string&& error) {
+  std::lock_guard lock{m_mutex};
+
+  m_posting = false;
+  m_dirty.store(true, std::memory_order_relaxed);
+  m_stats.failed++;
+  m_stats.consecutive_failures++;
+  m_stats.last_error = std::optional{std::move(error)};
+}
+
+static std::string describe_failure(const dpp::http_request_completion_t& response) {
+  if (response.error != dpp::h_success) {
+    return "Request failed with D++ HTTP error " + std::to_string(static_cast<int>(response.error)) + ".";
+  }
+
+  return "Top.gg responded with HTTP status " + std::to_string(response.status) + ".";
+}
+
+/**
+ * A failed post is tried again on the next tick that is due, since the last posted hash is left untouched.
+ */
+void autoposter::complete(const size_t hash, const dpp::http_request_completion_t& response, const size_t attempts, const uint16_t retry_after, const steady_clock::time_point started_at) {
+  const auto now = steady_clock::now();
+  autopost_event event{};
+
+  event.success = response.error == dpp::h_success && response.status < 300;
+  event.status = response.error == dpp::h_success ? response.status : 0;
+  event.error = response.error;
+  event.latency = std::chrono::duration_cast<std::chrono::milliseconds>(now - started_at);
+  event.attempts = attempts;
+  event.retry_after = retry_after;
+
+  {
+    std::lock_guard lock{m_mutex};
+
+    m_posting = false;
+    m_stats.last_latency = event.latency;
+
+    if (event.success) {
+      m_last_hash = std::optional{hash};
+      m_stats.posted++;
+      m_stats.consecutive_failures = 0;
+      m_stats.last_posted_at = std::optional{std::chrono::system_clock::now()};
+      m_stats.last_error.reset();
+    } else {
+      m_dirty.store(true, std::memory_order_relaxed);
+      m_stats.failed++;
+      m_stats.consecutive_failures++;
+      m_stats.last_error = std::optional{describe_failure(response)};
+
+      if (retry_after != 0) {
+        m_retry_at = std::optional{now + std::chrono::seconds{retry_after}};
+        m_stats.ratelimited++;
+      }
+    }
+
+    event.consecutive_failures = m_stats.consecutive_failures;
+  }
+
+  const auto& observer = event.success ? m_options.on_success : m_options.on_failure;
+
+  if (observer) {
+    observer(event);
+  }
+}
+
+autopost_stats autoposter::stats() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  return m_stats;
+}
+
+autoposter::~autoposter() {
+  if (m_guild_create) {
+    m_cluster.on_guild_create.detach(m_guild_create);
+  }
+
+  if (m_guild_delete) {
+    m_cluster.on_guild_delete.detach(m_guild_delete);
+  }
+}
@@ -0,0 +1,95 @@
+#include <topgg/topgg.h>
+
+using topgg::vote_cache;
+
+/**
+ * A user can only vote once every 12 hours, so a vote counts for exactly that long after it's cast.
+ * A has_voted lookup doesn't say when the vote was cast, it may already be almost 12 hours old, so a positive lookup is only cached for voted_ttl.
+ * Only a vote whose time is known, like one just received by a webhook, is cached for the whole 12 hours.
+ */
+static constexpr time_t vote_window = 12 * 60 * 60;
+
+vote_cache::vote_cache(const time_t ttl, const time_t voted_ttl, const size_t max_size)
+  : m_ttl(ttl), m_voted_ttl(std::min(voted_ttl, vote_window)), m_max_size(max_size) {
+  if (max_size == 0) {
+    throw std::invalid_argument{"Cache size mustn't be zero."};
+  }
+
+  m_index.reserve(max_size);
+}
+
+std::optional<bool> vote_cache::get(const dpp::snowflake user_id) {
+  std::lock_guard lock{m_mutex};
+
+  const auto it = m_index.find(user_id);
+
+  if (it == m_index.end()) {
+    return std::nullopt;
+  }
+
+  if (it->second->expires_at <= std::chrono::steady_clock::now()) {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+
+    return std::nullopt;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+  return std::optional{it->second->voted};
+}
+
+void vote_cache::insert(const dpp::snowflake user_id, const bool voted) {
+  store(user_id, voted, voted ? m_voted_ttl : m_ttl);
+}
+
+void vote_cache::insert_vote(const dpp::snowflake user_id) {
+  store(user_id, true, std::chrono::seconds{vote_window});
+}
+
+void vote_cache::store(const dpp::snowflake user_id, const bool voted, const std::chrono::seconds ttl) {
+  std::lock_guard lock{m_mutex};
+
+  const auto expires_at = std::chrono::steady_clock::now() + ttl;
+  const auto it = m_index.find(user_id);
+
+  if (it != m_index.end()) {
+    it->second->voted = voted;
+    it->second->expires_at = expires_at;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+    return;
+  }
+
+  if (m_entries.size() >= m_max_size) {
+    m_index.erase(m_entries.back().user_id);
+    m_entries.pop_back();
+  }
+
+  m_entries.push_front(entry{user_id, voted, expires_at});
+  m_index.insert(std::pair(user_id, m_entries.begin()));
+}
+
+void vote_cache::invalidate(const dpp::snowflake user_id) {
+  std::lock_guard lock{m_mutex};
+
+  const auto it = m_index.find(user_id);
+
+  if (it != m_index.end()) {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+}
+
+void vote_cache::clear() {
+  std::lock_guard lock{m_mutex};
+
+  m_entries.clear();
+  m_index.clear();
+}
+
+size_t vote_cache::size() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  return m_entries.size();
+}
@@ -1,13 +1,296 @@
 #include <topgg/topgg.h>
 
+#include <unordered_set>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
 using topgg::client;
 
-client::client(dpp::cluster& cluster, const std::string& token): m_token(token), m_cluster(cluster), m_autoposter_timer(0) {
-  m_headers.insert(std::pair("Authorization", "Bearer " + token));
-  m_headers.insert(std::pair("Connection", "close"));
-  m_headers.insert(std::pair("Content-Type", "application/json"));
-  m_headers.insert(std::pair("User-Agent", "topgg (https://github.com/top-gg-community/cpp-sdk) D++"));
+client::client(dpp::cluster& cluster, const std::string& token): m_token(token), m_cluster(cluster), m_autoposter_timer(0), m_inflight(std::make_shared<inflight_requests>()) {
+  m_context = std::make_shared<const request_context>(request_context{
+    cluster,
+    headers_t{
+      {"Accept-Encoding", "gzip"},
+      {"Authorization", "Bearer " + token},
+      {"Connection", "close"},
+      {"Content-Type", "application/json"},
+      {"User-Agent", "topgg (https://github.com/top-gg-community/cpp-sdk) D++"},
+    },
+    std::make_shared<dpp_transport>(cluster),
+    "https://top.gg/api",
+    32 * 1024 * 1024,
+    nullptr,
+    nullptr,
+    std::nullopt,
+    std::make_shared<retry_timers>(),
+  });
+}
+
+void client::update_context(const std::function<void(request_context&)>& update) {
+  auto context = std::make_shared<request_context>(*m_context);
+
+  update(*context);
+
+  m_context = std::move(context);
+}
+
+/**
+ * D++ computes the Content-Length header from the request body by itself,
+ * so the same header block can be shared by every request without copying it.
+ */
+void client::send(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dpp::http_completion_event&& callback) {
+  context->transport->request(context->base_url + url, method, body, context->headers, track(context->metrics, url, method, std::move(callback)));
+}
+
+/**
+ * Latency is measured from the moment the request is handed to the transport.
+ */
+dpp::http_completion_event client::track(const std::shared_ptr<metrics_registry>& metrics, const std::string& url, const dpp::http_method method, dpp::http_completion_event&& callback) {
+  if (!metrics) {
+    return std::move(callback);
+  }
+
+  const auto slot_index = metrics->begin(url, method);
+
+  return [metrics, slot_index, started_at = std::chrono::steady_clock::now(), callback_in = std::move(callback)](const auto& response) {
+    metrics->end(slot_index, started_at, response);
+    callback_in(response);
+  };
+}
+
+void client::set_transport(const std::shared_ptr<transport>& new_transport) {
+  if (!new_transport) {
+    throw std::invalid_argument{"Transport mustn't be null."};
+  }
+
+  update_context([&new_transport](auto& context) {
+    context.transport = new_transport;
+  });
+}
+
+void client::set_base_url(const std::string& base_url) {
+  update_context([&base_url](auto& context) {
+    context.base_url = base_url;
+  });
+}
+
+void client::set_max_body_size(const size_t max_body_size) {
+  if (max_body_size == 0) {
+    throw std::invalid_argument{"Maximum body size mustn't be zero."};
+  }
+
+  update_context([max_body_size](auto& context) {
+    context.max_body_size = max_body_size;
+  });
+}
+
+/**
+ * Retrieves the amount of seconds Top.gg asks us to wait for from a 429 response, defaulting to one second.
+ */
+static uint16_t retry_after_of(const dpp::http_request_completion_t& response, const size_t max_body_size) {
+  try {
+    const auto j = dpp::json::parse(topgg::internal_result::decode(response.body, max_body_size));
+
+    return std::max<uint16_t>(j["retry_after"].template get<uint16_t>(), 1);
+  } catch (TOPGG_UNUSED const std::exception&) {}
+
+  for (const auto& header: response.headers) {
+    if (dpp::lowercase(header.first) == "retry-after") {
+      try {
+        return std::max<uint16_t>(static_cast<uint16_t>(std::stoul(header.second)), 1);
+      } catch (TOPGG_UNUSED const std::exception&) {}
+    }
+  }
+
+  return 1;
+}
+
+void client::throttled_send(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dpp::http_completion_event&& callback, const bool can_requeue) {
+  context->limiter->schedule(url, [context, url, method, body, callback_in = std::move(callback), can_requeue]() {
+    send(context, url, method, body, [context, url, method, body, callback_in, can_requeue](const auto& response) {
+      if (response.error == dpp::h_success && response.status == 429) {
+        context->limiter->block(retry_after_of(response, context->max_body_size));
+
+        /**
+         * Put the request back in the queue once, it will be sent again after the retry_after window.
+         */
+        if (can_requeue) {
+          throttled_send(context, url, method, body, dpp::http_completion_event{callback_in}, false);
+          return;
+        }
+      }
+
+      callback_in(response);
+    });
+  });
+}
+
+static bool is_retryable(const topgg::retry_policy& policy, const dpp::http_request_completion_t& response) {
+  if (response.error != dpp::h_success) {
+    return std::find(policy.retryable_errors.begin(), policy.retryable_errors.end(), response.error) != policy.retryable_errors.end();
+  }
+
+  return policy.retry_server_errors && response.status >= 500;
+}
+
+static time_t retry_delay_of(const topgg::retry_policy& policy, const size_t attempt) {
+  static thread_local std::mt19937 rng{std::random_device{}()};
+
+  std::uniform_real_distribution<double> spread{1.0 - policy.jitter, 1.0 + policy.jitter};
+  const auto delay = static_cast<double>(policy.base_delay) * static_cast<double>(1ULL << std::min<size_t>(attempt - 1, 16)) * spread(rng);
+
+  /**
+   * D++ timers tick in whole seconds.
+   */
+  return std::max<time_t>(static_cast<time_t>(std::llround(delay)), 1);
+}
+
+/**
+ * Everything the response and the retry timer need is captured from the request context, never from the client itself.
+ */
+void client::dispatch(const std::shared_ptr<const request_context>& context, const std::string& url, const dpp::http_method method, const std::string& body, dispatch_completion_t&& callback, const size_t attempt) {
+  auto on_response = [context, url, method, body, callback_in = std::move(callback), attempt](const auto& response) {
+    const auto& policy = context->retry;
+
+    if (!policy.has_value() || attempt >= policy->max_attempts || !is_retryable(policy.value(), response)) {
+      callback_in(response, attempt);
+      return;
+    }
+
+    const auto& timers = context->timers;
+
+    {
+      std::unique_lock lock{timers->mutex};
+
+      if (timers->stopped) {
+        lock.unlock();
+        callback_in(response, attempt);
+        return;
+      }
+    }
+
+    /**
+     * Whoever claims the retry first, its timer or the client's destructor, is the only one to continue it.
+     * If the client is destroyed meanwhile, the callback is called with this attempt's response instead of being dropped.
+     */
+    auto retry = std::make_shared<retry_timers::retry>();
+
+    retry->cancel = [callback_in, response, attempt]() {
+      callback_in(response, attempt);
+    };
+
+    /**
+     * D++ timers are started and stopped outside of the lock, as D++ takes its own timer lock for both.
+     */
+    const auto timer = context->cluster.start_timer([context, url, method, body, callback_in, attempt, retry](dpp::timer timer) {
+      context->cluster.stop_timer(timer);
+
+      {
+        std::lock_guard lock{context->timers->mutex};
+
+        if (retry->claimed) {
+          return;
+        }
+
+        retry->claimed = true;
+        context->timers->pending.erase(timer);
+      }
+
+      dispatch(context, url, method, body, dispatch_completion_t{callback_in}, attempt + 1);
+    }, static_cast<uint64_t>(retry_delay_of(policy.value(), attempt)));
+
+    std::unique_lock lock{timers->mutex};
+
+    if (retry->claimed) {
+      return;
+    } else if (timers->stopped) {
+      retry->claimed = true;
+      lock.unlock();
+
+      context->cluster.stop_timer(timer);
+      retry->cancel();
+    } else {
+      timers->pending.insert(std::pair(timer, retry));
+    }
+  };
+
+  if (context->limiter) {
+    throttled_send(context, url, method, body, std::move(on_response), true);
+  } else {
+    send(context, url, method, body, std::move(on_response));
+  }
+}
+
+void client::dispatch(const std::string& url, const dpp::http_method method, const std::string& body, dispatch_completion_t&& callback) {
+  dispatch(m_context, url, method, body, std::move(callback), 1);
+}
+
+void client::set_retry_policy(const topgg::retry_policy& policy) {
+  if (policy.max_attempts == 0) {
+    throw std::invalid_argument{"Maximum attempts mustn't be zero."};
+  } else if (policy.jitter < 0 || policy.jitter > 1) {
+    throw std::invalid_argument{"Jitter must be between 0 and 1."};
+  }
+
+  update_context([&policy](auto& context) {
+    context.retry = std::optional{policy};
+  });
+}
+
+void client::enable_ratelimiter() {
+  if (!m_context->limiter) {
+    update_context([limiter = std::shared_ptr<ratelimiter>{new ratelimiter{m_cluster}}](auto& context) {
+      context.limiter = limiter;
+    });
+  }
+}
+
+topgg::ratelimit_stats client::ratelimiter_stats() const noexcept {
+  if (!m_context->limiter) {
+    return ratelimit_stats{};
+  }
+
+  return m_context->limiter->stats();
+}
+
+void client::enable_metrics() {
+  if (!m_context->metrics) {
+    update_context([metrics = std::shared_ptr<metrics_registry>{new metrics_registry{}}](auto& context) {
+      context.metrics = metrics;
+    });
+  }
+}
+
+topgg::metrics_snapshot client::metrics() const {
+  if (!m_context->metrics) {
+    return metrics_snapshot{};
+  }
+
+  return m_context->metrics->snapshot();
+}
+
+void client::enable_guild_counting() {
+  if (!m_guild_counter) {
+    m_guild_counter = std::make_shared<guild_counter>(m_cluster);
+  }
+}
+
+#ifndef _WIN32
+void client::enable_stats_aggregation(const std::string& socket_path, const time_t interval) {
+  if (!m_aggregator) {
+    m_aggregator = std::shared_ptr<stats_aggregator>{new stats_aggregator{m_cluster, socket_path, interval}};
+  }
+}
+
+topgg::aggregation_stats client::aggregator_stats() const noexcept {
+  if (!m_aggregator) {
+    return aggregation_stats{false, 0, 0, 0};
+  }
+
+  return m_aggregator->stats();
 }
+#endif
 
 void client::get_bot(const dpp::snowflake bot_id, const topgg::get_bot_completion_t& callback) {
   basic_request<topgg::bot>("/bots/" + std::to_string(bot_id), callback, [](const auto& j) {
@@ -34,22 +317,17 @@ topgg::async_result<topgg::user> client::co_get_user(const dpp::snowflake user_i
 #endif
 
 void client::post_stats(const topgg::post_stats_completion_t& callback)  {
-  post_stats(stats{m_cluster}, callback);
+  post_stats(m_guild_counter ? m_guild_counter->snapshot() : stats{m_cluster}, callback);
 }
 
 #ifdef DPP_CORO
 dpp::async<bool> client::co_post_stats() {
-  return dpp::async<bool>{ [this] <typename C> (C&& cc) { return post_stats(stats{m_cluster}, std::forward<C>(cc)); }};
+  return dpp::async<bool>{ [this] <typename C> (C&& cc) { return post_stats(m_guild_counter ? m_guild_counter->snapshot() : stats{m_cluster}, std::forward<C>(cc)); }};
 }
 #endif
 
 void client::post_stats(const stats& s, const topgg::post_stats_completion_t& callback)  {
-  auto headers = std::multimap<std::string, std::string>{m_headers};
-  const auto s_json = s.to_json();
-
-  headers.insert(std::pair("Content-Length", std::to_string(s_json.size())));
-
-  m_cluster.request("https://top.gg/api/bots/stats", dpp::m_post, [callback](const auto& response) { callback(response.error == dpp::h_success && response.status < 400); }, s_json, "application/json", headers);
+  dispatch("/bots/stats", dpp::m_post, s.to_json(), [callback](const auto& response, TOPGG_UNUSED const size_t attempts) { callback(response.error == dpp::h_success && response.status < 400); });
 }
 
 #ifdef DPP_CORO
@@ -71,14 +349,8 @@ topgg::async_result<topgg::stats> client::co_get_stats() {
 #endif
 
 void client::get_voters(const topgg::get_voters_completion_t& callback) {
-  basic_request<std::vector<topgg::voter>>("/bots/votes", callback, [](const auto& j) {
-    std::vector<topgg::voter> voters;
-
-    for (const auto& part: j) {
-      voters.push_back(topgg::voter{part});
-    }
-
-    return voters;
+  raw_request<std::vector<topgg::voter>>("/bots/votes", callback, [](const auto& body) {
+    return topgg::voter::parse_list(body);
   });
 }
 
@@ -88,9 +360,44 @@ topgg::async_result<std::vector<topgg::voter>> client::co_get_voters() {
 }
 #endif
 
+void client::get_voter_list(const topgg::get_voter_list_completion_t& callback) {
+  raw_request<topgg::voter_list>("/bots/votes", callback, [](const auto& body) {
+    return topgg::voter_list::parse(body);
+  });
+}
+
+#ifdef DPP_CORO
+topgg::async_result<topgg::voter_list> client::co_get_voter_list() {
+  return topgg::async_result<topgg::voter_list>{ [this] <typename C> (C&& cc) { return get_voter_list(std::forward<C>(cc)); }};
+}
+#endif
+
 
 void client::has_voted(const dpp::snowflake user_id, const topgg::has_voted_completion_t& callback) {
-  basic_request<bool>("/bots/votes?userId=" + std::to_string(user_id), callback, [](const auto& j) {
+  if (!m_vote_cache) {
+    basic_request<bool>("/bots/votes?userId=" + std::to_string(user_id), callback, [](const auto& j) {
+      return j["voted"].template get<uint8_t>() != 0;
+    });
+
+    return;
+  }
+
+  if (const auto voted = m_vote_cache->get(user_id); voted.has_value()) {
+    callback(topgg::result<bool>{voted.value()});
+    return;
+  }
+
+  basic_request<bool>("/bots/votes?userId=" + std::to_string(user_id), [cache = m_vote_cache, user_id, callback](const auto& result) {
+    /**
+     * result::get() is memoized, so peeking at the result here doesn't make the callback parse it twice.
+     * Errors (including dpp::http_error) are left for the callback to handle.
+     */
+    try {
+      cache->insert(user_id, result.get());
+    } catch (...) {}
+
+    callback(result);
+  }, [](const auto& j) {
     return j["voted"].template get<uint8_t>() != 0;
   });
 }
@@ -101,6 +408,205 @@ topgg::async_result<bool> client::co_has_voted(const dpp::snowflake user_id) {
 }
 #endif
 
+/**
+ * The /bots/votes endpoint only returns the last 1000 votes.
+ */
+static constexpr size_t max_voters = 1000;
+
+/**
+ * The maximum amount of individual has_voted requests has_voted_many keeps in flight at once.
+ */
+static constexpr size_t max_fallback_requests = 4;
+
+struct client::vote_fallback {
+  std::mutex mutex;
+  std::vector<dpp::snowflake> user_ids;
+  size_t next;
+  size_t in_flight;
+  bool sending;
+  std::exception_ptr error;
+  std::unordered_map<dpp::snowflake, bool> statuses;
+  has_voted_many_completion_t callback;
+};
+
+/**
+ * Sends individual requests until max_fallback_requests are in flight. Every completed request calls this again to send the next one.
+ * Only one call sends at a time, so a transport that completes requests inline loops here instead of recursing once per user.
+ */
+void client::check_fallback_votes(const std::shared_ptr<const request_context>& context, const std::shared_ptr<vote_cache>& cache, const std::shared_ptr<vote_fallback>& fallback) {
+  {
+    std::lock_guard lock{fallback->mutex};
+
+    if (fallback->sending) {
+      return;
+    }
+
+    fallback->sending = true;
+  }
+
+  while (true) {
+    dpp::snowflake user_id{};
+
+    {
+      std::lock_guard lock{fallback->mutex};
+
+      if (fallback->next == fallback->user_ids.size() || fallback->in_flight == max_fallback_requests) {
+        fallback->sending = false;
+        return;
+      }
+
+      user_id = fallback->user_ids[fallback->next++];
+      fallback->in_flight++;
+    }
+
+    dispatch(context, "/bots/votes?userId=" + std::to_string(user_id), dpp::m_get, "", [context, cache, fallback, user_id](const auto& response, const size_t attempts) {
+      const result<bool> voted_result{response, [](const std::string& body) {
+        return dpp::json::parse(body)["voted"].template get<uint8_t>() != 0;
+      }, attempts, context->max_body_size};
+
+      std::optional<bool> voted{};
+      std::exception_ptr error{};
+
+      try {
+        voted = voted_result.get();
+
+        if (cache) {
+          cache->insert(user_id, voted.value());
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      bool done = false;
+
+      {
+        std::lock_guard lock{fallback->mutex};
+
+        if (voted.has_value()) {
+          fallback->statuses.insert_or_assign(user_id, voted.value());
+        } else if (!fallback->error) {
+          /**
+           * The whole call fails with the first error, so the users that haven't been sent yet aren't.
+           */
+          fallback->error = error;
+          fallback->next = fallback->user_ids.size();
+        }
+
+        fallback->in_flight--;
+        done = fallback->in_flight == 0 && fallback->next == fallback->user_ids.size();
+      }
+
+      if (!done) {
+        check_fallback_votes(context, cache, fallback);
+      } else if (fallback->error) {
+        fallback->callback(result<std::unordered_map<dpp::snowflake, bool>>{fallback->error});
+      } else {
+        fallback->callback(result<std::unordered_map<dpp::snowflake, bool>>{fallback->statuses});
+      }
+    }, 1);
+  }
+}
+
+void client::has_voted_many(const std::vector<dpp::snowflake>& user_ids, const topgg::has_voted_many_completion_t& callback) {
+  using statuses_t = std::unordered_map<dpp::snowflake, bool>;
+
+  auto fallback = std::make_shared<vote_fallback>();
+
+  fallback->next = 0;
+  fallback->in_flight = 0;
+  fallback->sending = false;
+  fallback->callback = callback;
+  fallback->statuses.reserve(user_ids.size());
+
+  std::vector<dpp::snowflake> remaining{};
+
+  remaining.reserve(user_ids.size());
+
+  for (const auto user_id: user_ids) {
+    if (m_vote_cache) {
+      if (const auto voted = m_vote_cache->get(user_id); voted.has_value()) {
+        fallback->statuses.insert_or_assign(user_id, voted.value());
+        continue;
+      }
+    }
+
+    remaining.push_back(user_id);
+  }
+
+  if (remaining.empty()) {
+    callback(topgg::result<statuses_t>{fallback->statuses});
+    return;
+  }
+
+  /**
+   * Like every response callback, this one captures the request context instead of the client, which may be destroyed before it's called.
+   */
+  get_voters([context = m_context, cache = m_vote_cache, fallback, remaining = std::move(remaining)](const auto& voters_result) {
+    try {
+      const auto& voters = voters_result.get();
+      const auto is_complete = voters.size() < max_voters;
+      std::unordered_set<dpp::snowflake> voter_ids{};
+
+      voter_ids.reserve(voters.size());
+
+      for (const auto& voter: voters) {
+        voter_ids.insert(voter.id);
+      }
+
+      /**
+       * The voters list holds the last 1000 votes of any age, without timestamps. A user in it may have voted more than 12 hours ago,
+       * so the list can only tell that a user hasn't voted, and only if it isn't truncated.
+       * Only individual requests can tell whether the other users voted within the last 12 hours.
+       */
+      for (const auto user_id: remaining) {
+        if (is_complete && voter_ids.count(user_id) == 0) {
+          fallback->statuses.insert_or_assign(user_id, false);
+        } else {
+          fallback->user_ids.push_back(user_id);
+        }
+      }
+    } catch (...) {
+      fallback->callback(topgg::result<statuses_t>{std::current_exception()});
+      return;
+    }
+
+    if (fallback->user_ids.empty()) {
+      fallback->callback(topgg::result<statuses_t>{fallback->statuses});
+      return;
+    }
+
+    check_fallback_votes(context, cache, fallback);
+  });
+}
+
+#ifdef DPP_CORO
+topgg::async_result<std::unordered_map<dpp::snowflake, bool>> client::co_has_voted_many(const std::vector<dpp::snowflake>& user_ids) {
+  return topgg::async_result<std::unordered_map<dpp::snowflake, bool>>{ [user_ids, this] <typename C> (C&& cc) { return has_voted_many(user_ids, std::forward<C>(cc)); }};
+}
+#endif
+
+void client::enable_vote_cache(const time_t ttl, const time_t voted_ttl, const size_t max_size) {
+  if (!m_vote_cache) {
+    m_vote_cache = std::shared_ptr<vote_cache>{new vote_cache{ttl, voted_ttl, max_size}};
+  }
+}
+
+void client::cache_vote(const dpp::snowflake user_id, const bool voted) {
+  if (!m_vote_cache) {
+    return;
+  } else if (voted) {
+    m_vote_cache->insert_vote(user_id);
+  } else {
+    m_vote_cache->insert(user_id, false);
+  }
+}
+
+void client::invalidate_vote(const dpp::snowflake user_id) {
+  if (m_vote_cache) {
+    m_vote_cache->invalidate(user_id);
+  }
+}
+
 void client::is_weekend(const topgg::is_weekend_completion_t& callback) {
   basic_request<bool>("/weekend", callback, [](const auto& j) {
     return j["is_weekend"].template get<bool>();
@@ -114,9 +620,16 @@ topgg::async_result<bool> client::co_is_weekend() {
 #endif
 
 void client::start_autoposter(const time_t delay) {
-  start_autoposter([](dpp::cluster& bot) {
-    return stats{bot};
-  }, delay);
+  if (delay < 15 * 60) {
+    throw std::invalid_argument{"Delay mustn't be shorter than 15 minutes."};
+  }
+
+  autopost_options options{};
+
+  options.min_interval = delay;
+  options.max_interval = delay;
+
+  start_autoposter(options);
 }
 
 void client::start_autoposter(const topgg::custom_autopost_callback_t& callback, const time_t delay) {
@@ -126,30 +639,120 @@ void client::start_autoposter(const topgg::custom_autopost_callback_t& callback,
   if (delay < 15 * 60) {
     throw std::invalid_argument{"Delay mustn't be shorter than 15 minutes."};
   }
-  
+
+  autopost_options options{};
+
+  options.min_interval = delay;
+  options.max_interval = delay;
+
+  start_autoposter(callback, options);
+}
+
+void client::start_autoposter(const topgg::autopost_options& options) {
+#ifndef _WIN32
+  if (m_aggregator) {
+    start_autoposter([aggregator = m_aggregator](TOPGG_UNUSED dpp::cluster& bot) {
+      return aggregator->merged();
+    }, options);
+
+    return;
+  }
+#endif
+
+  if (m_guild_counter) {
+    start_autoposter([counter = m_guild_counter](TOPGG_UNUSED dpp::cluster& bot) {
+      return counter->snapshot();
+    }, options);
+
+    return;
+  }
+
+  start_autoposter([](dpp::cluster& bot) {
+    return stats{bot};
+  }, options);
+}
+
+void client::start_autoposter(const topgg::custom_autopost_callback_t& callback, const topgg::autopost_options& options) {
+  if (options.max_interval < 15 * 60) {
+    throw std::invalid_argument{"Maximum interval mustn't be shorter than 15 minutes."};
+  } else if (options.on_guild_events && options.min_interval < 60) {
+    throw std::invalid_argument{"Minimum interval mustn't be shorter than a minute."};
+  } else if (options.on_guild_events && options.min_interval > options.max_interval) {
+    throw std::invalid_argument{"Minimum interval mustn't be longer than the maximum interval."};
+  }
+
   /**
    * Create a D++ timer, this is managed by the D++ cluster and ticks every n seconds.
    * It can be stopped at any time without blocking, and does not need to create extra threads.
    */
   if (!m_autoposter_timer) {
-    m_autoposter_timer = m_cluster.start_timer([this, callback](TOPGG_UNUSED dpp::timer) {
-      const auto s = callback(m_cluster);
-      const auto s_json = s.to_json();
-      std::multimap<std::string, std::string> headers{m_headers};
-      headers.insert(std::pair("Content-Length", std::to_string(s_json.length())));
-      
-      m_cluster.request("https://top.gg/api/bots/stats", dpp::m_post, [](TOPGG_UNUSED const auto&) {}, s_json, "application/json", headers);
-    }, delay);
+    m_autoposter = std::shared_ptr<autoposter>{new autoposter{m_cluster, callback, options}};
+
+#ifndef _WIN32
+    m_autoposter_timer = m_cluster.start_timer([this, poster = m_autoposter, aggregator = m_aggregator](TOPGG_UNUSED dpp::timer) {
+      /**
+       * Only the leader posts. Server counts changed by other processes count as joins and leaves too.
+       */
+      if (aggregator) {
+        if (!aggregator->is_leader()) {
+          return;
+        } else if (aggregator->take_changed()) {
+          poster->m_dirty.store(true, std::memory_order_relaxed);
+        }
+      }
+#else
+    m_autoposter_timer = m_cluster.start_timer([this, poster = m_autoposter](TOPGG_UNUSED dpp::timer) {
+#endif
+      auto due = poster->next();
+
+      if (!due.has_value()) {
+        return;
+      }
+
+      dispatch("/bots/stats", dpp::m_post, due->first, [poster, hash = due->second, started_at = std::chrono::steady_clock::now(), max_body_size = m_context->max_body_size](const auto& response, const size_t attempts) {
+        const auto retry_after = response.error == dpp::h_success && response.status == 429 ? retry_after_of(response, max_body_size) : 0;
+
+        poster->complete(hash, response, attempts, retry_after, started_at);
+      });
+    }, static_cast<uint64_t>(m_autoposter->tick_interval()));
   }
 }
 
+topgg::autopost_stats client::autoposter_stats() const noexcept {
+  if (!m_autoposter) {
+    return autopost_stats{};
+  }
+
+  return m_autoposter->stats();
+}
+
 void client::stop_autoposter() noexcept {
   if (m_autoposter_timer) {
     m_cluster.stop_timer(m_autoposter_timer);
     m_autoposter_timer = 0;
   }
+
+  m_autoposter.reset();
 }
 
 client::~client() {
   stop_autoposter();
-}
\ No newline at end of file
+
+  std::unordered_map<dpp::timer, std::shared_ptr<retry_timers::retry>> pending{};
+
+  {
+    std::lock_guard lock{m_context->timers->mutex};
+
+    m_context->timers->stopped = true;
+    pending.swap(m_context->timers->pending);
+
+    for (auto& entry: pending) {
+      entry.second->claimed = true;
+    }
+  }
+
+  for (const auto& entry: pending) {
+    m_cluster.stop_timer(entry.first);
+    entry.second->cancel();
+  }
+}
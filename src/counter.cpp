@@ -0,0 +1,106 @@
+#include <topgg/topgg.h>
+
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+using topgg::guild_counter;
+
+/**
+ * D++ 10.1 and above store the shard ID on every event. Older versions only expose the shard itself.
+ */
+template<typename T>
+static uint32_t shard_of(const T& event) noexcept {
+#if defined(DPP_VERSION_LONG) && DPP_VERSION_LONG >= 0x00100100
+  return event.shard;
+#else
+  return event.from->shard_id;
+#endif
+}
+
+guild_counter::guild_counter(dpp::cluster& cluster)
+  : m_cluster(cluster), m_shard_count(cluster.numshards), m_ready(0), m_guild_create(0), m_guild_delete(0) {
+  if (m_shard_count == 0) {
+    throw std::invalid_argument{"The cluster's shard count must be known before counting its servers."};
+  }
+
+  m_shards = std::make_unique<shard_counter[]>(m_shard_count);
+
+  /**
+   * Seeded in a single pass over the guild cache, instead of one pass per shard.
+   */
+  if (const auto cache = dpp::get_guild_cache(); cache != nullptr) {
+    std::shared_lock lock{cache->get_mutex()};
+
+    for (const auto& entry: cache->get_container()) {
+      if (entry.second->shard_id < m_shard_count) {
+        m_shards[entry.second->shard_id].guilds.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  m_ready = m_cluster.on_ready.attach([this](const dpp::ready_t& event) {
+    reset(shard_of(event));
+  });
+
+  m_guild_create = m_cluster.on_guild_create.attach([this](const dpp::guild_create_t& event) {
+    added(shard_of(event));
+  });
+
+  m_guild_delete = m_cluster.on_guild_delete.attach([this](const dpp::guild_delete_t& event) {
+    removed(shard_of(event));
+  });
+}
+
+void guild_counter::added(const uint32_t shard_id) noexcept {
+  if (shard_id < m_shard_count) {
+    m_shards[shard_id].guilds.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Never goes below zero, even if a server left that was joined before this counter was seeded.
+ */
+void guild_counter::removed(const uint32_t shard_id) noexcept {
+  if (shard_id >= m_shard_count) {
+    return;
+  }
+
+  auto& guilds = m_shards[shard_id].guilds;
+  auto current = guilds.load(std::memory_order_relaxed);
+
+  while (current != 0 && !guilds.compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {}
+}
+
+/**
+ * A new READY is followed by a GUILD_CREATE for every server the shard is in.
+ */
+void guild_counter::reset(const uint32_t shard_id) noexcept {
+  if (shard_id < m_shard_count) {
+    m_shards[shard_id].guilds.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t guild_counter::server_count(const uint32_t shard_id) const noexcept {
+  if (shard_id >= m_shard_count) {
+    return 0;
+  }
+
+  return m_shards[shard_id].guilds.load(std::memory_order_relaxed);
+}
+
+topgg::stats guild_counter::snapshot() const {
+  std::vector<size_t> shards(m_shard_count);
+
+  for (uint32_t i = 0; i < m_shard_count; i++) {
+    shards[i] = m_shards[i].guilds.load(std::memory_order_relaxed);
+  }
+
+  return ::topgg::stats{shards};
+}
+
+guild_counter::~guild_counter() {
+  m_cluster.on_ready.detach(m_ready);
+  m_cluster.on_guild_create.detach(m_guild_create);
+  m_cluster.on_guild_delete.detach(m_guild_delete);
+}
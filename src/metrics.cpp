@@ -0,0 +1,213 @@
+#include <topgg/topgg.h>
+
+#include <algorithm>
+#include <cstdio>
+
+using topgg::endpoint_metrics;
+using topgg::metrics_registry;
+using topgg::metrics_snapshot;
+
+using std::chrono::steady_clock;
+
+static constexpr const char* route_names[] = {"/bots/:id", "/users/:id", "/bots/votes", "/bots/stats", "/weekend", "other"};
+static constexpr const char* method_names[] = {"GET", "POST"};
+
+/**
+ * The upper bounds of every latency bucket in milliseconds, except for the last one which has no upper bound.
+ */
+static constexpr int64_t latency_bounds_ms[] = {5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+size_t metrics_registry::slot_of(const std::string& url, const dpp::http_method method) noexcept {
+  size_t route = 5;
+
+  if (url.rfind("/bots/votes", 0) == 0) {
+    route = 2;
+  } else if (url.rfind("/bots/stats", 0) == 0) {
+    route = 3;
+  } else if (url.rfind("/bots/", 0) == 0) {
+    route = 0;
+  } else if (url.rfind("/users/", 0) == 0) {
+    route = 1;
+  } else if (url.rfind("/weekend", 0) == 0) {
+    route = 4;
+  }
+
+  return route * method_count + (method == dpp::m_post ? 1 : 0);
+}
+
+size_t metrics_registry::begin(const std::string& url, const dpp::http_method method) noexcept {
+  const auto slot_index = slot_of(url, method);
+
+  m_slots[slot_index].in_flight.fetch_add(1, std::memory_order_relaxed);
+
+  return slot_index;
+}
+
+void metrics_registry::end(const size_t slot_index, const steady_clock::time_point started_at, const dpp::http_request_completion_t& response) noexcept {
+  auto& s = m_slots[slot_index];
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - started_at);
+  const auto elapsed_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+  const auto bucket = std::lower_bound(std::begin(latency_bounds_ms), std::end(latency_bounds_ms), elapsed_ms) - std::begin(latency_bounds_ms);
+
+  s.latency_buckets[static_cast<size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+  s.total_latency_ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+  s.bytes_received.fetch_add(response.body.size(), std::memory_order_relaxed);
+
+  if (response.error != dpp::h_success) {
+    s.errors[std::min<size_t>(static_cast<size_t>(response.error), error_count - 1)].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    s.statuses[response.status < status_count ? response.status : 0].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  s.requests.fetch_add(1, std::memory_order_relaxed);
+  s.in_flight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+metrics_snapshot metrics_registry::snapshot() const {
+  metrics_snapshot snapshot{};
+
+  for (const auto bound: latency_bounds_ms) {
+    snapshot.latency_bounds.push_back(std::chrono::milliseconds{bound});
+  }
+
+  for (size_t i = 0; i < m_slots.size(); i++) {
+    const auto& s = m_slots[i];
+    const auto in_flight = s.in_flight.load(std::memory_order_relaxed);
+    const auto requests = s.requests.load(std::memory_order_relaxed);
+
+    if (requests == 0 && in_flight == 0) {
+      continue;
+    }
+
+    endpoint_metrics endpoint{};
+
+    endpoint.route = route_names[i / method_count];
+    endpoint.method = method_names[i % method_count];
+    endpoint.requests = requests;
+    endpoint.in_flight = in_flight;
+    endpoint.bytes_received = s.bytes_received.load(std::memory_order_relaxed);
+    endpoint.total_latency = std::chrono::nanoseconds{s.total_latency_ns.load(std::memory_order_relaxed)};
+
+    for (const auto& bucket: s.latency_buckets) {
+      endpoint.latency_buckets.push_back(bucket.load(std::memory_order_relaxed));
+    }
+
+    for (size_t status = 0; status < status_count; status++) {
+      if (const auto count = s.statuses[status].load(std::memory_order_relaxed); count != 0) {
+        endpoint.statuses.insert(std::pair{static_cast<uint16_t>(status), count});
+      }
+    }
+
+    for (size_t error = 0; error < error_count; error++) {
+      if (const auto count = s.errors[error].load(std::memory_order_relaxed); count != 0) {
+        endpoint.errors.insert(std::pair{static_cast<dpp::http_error>(error), count});
+      }
+    }
+
+    snapshot.endpoints.push_back(std::move(endpoint));
+  }
+
+  return snapshot;
+}
+
+static std::string error_name(const dpp::http_error error) {
+  switch (error) {
+  case dpp::h_unknown:
+    return "unknown";
+
+  case dpp::h_connection:
+    return "connection";
+
+  case dpp::h_bind_ip_address:
+    return "bind_ip_address";
+
+  case dpp::h_read:
+    return "read";
+
+  case dpp::h_write:
+    return "write";
+
+  case dpp::h_exceed_redirect_count:
+    return "exceed_redirect_count";
+
+  case dpp::h_canceled:
+    return "canceled";
+
+  case dpp::h_ssl_connection:
+    return "ssl_connection";
+
+  case dpp::h_ssl_loading_certs:
+    return "ssl_loading_certs";
+
+  case dpp::h_ssl_server_verification:
+    return "ssl_server_verification";
+
+  case dpp::h_unsupported_multipart_boundary_chars:
+    return "unsupported_multipart_boundary_chars";
+
+  case dpp::h_compression:
+    return "compression";
+
+  default:
+    return std::to_string(static_cast<int>(error));
+  }
+}
+
+static std::string seconds_of(const double seconds) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", seconds);
+
+  return buffer;
+}
+
+std::string metrics_snapshot::to_prometheus() const {
+  std::string output{};
+
+  output.append("# HELP topgg_request_duration_seconds Time spent waiting for Top.gg API responses.\n# TYPE topgg_request_duration_seconds histogram\n");
+
+  for (const auto& endpoint: endpoints) {
+    const auto labels = "route=\"" + endpoint.route + "\",method=\"" + endpoint.method + "\"";
+    size_t cumulative = 0;
+
+    for (size_t i = 0; i < endpoint.latency_buckets.size(); i++) {
+      cumulative += endpoint.latency_buckets[i];
+
+      const auto le = i < latency_bounds.size() ? seconds_of(static_cast<double>(latency_bounds[i].count()) / 1000.0) : std::string{"+Inf"};
+
+      output.append("topgg_request_duration_seconds_bucket{" + labels + ",le=\"" + le + "\"} " + std::to_string(cumulative) + "\n");
+    }
+
+    output.append("topgg_request_duration_seconds_sum{" + labels + "} " + seconds_of(std::chrono::duration<double>(endpoint.total_latency).count()) + "\n");
+    output.append("topgg_request_duration_seconds_count{" + labels + "} " + std::to_string(endpoint.requests) + "\n");
+  }
+
+  output.append("# HELP topgg_responses_total Top.gg API responses received, by HTTP status code.\n# TYPE topgg_responses_total counter\n");
+
+  for (const auto& endpoint: endpoints) {
+    for (const auto& [status, count]: endpoint.statuses) {
+      output.append("topgg_responses_total{route=\"" + endpoint.route + "\",method=\"" + endpoint.method + "\",status=\"" + std::to_string(status) + "\"} " + std::to_string(count) + "\n");
+    }
+  }
+
+  output.append("# HELP topgg_request_errors_total Top.gg API requests that failed without a response.\n# TYPE topgg_request_errors_total counter\n");
+
+  for (const auto& endpoint: endpoints) {
+    for (const auto& [error, count]: endpoint.errors) {
+      output.append("topgg_request_errors_total{route=\"" + endpoint.route + "\",method=\"" + endpoint.method + "\",error=\"" + error_name(error) + "\"} " + std::to_string(count) + "\n");
+    }
+  }
+
+  output.append("# HELP topgg_requests_in_flight Top.gg API requests currently waiting for a response.\n# TYPE topgg_requests_in_flight gauge\n");
+
+  for (const auto& endpoint: endpoints) {
+    output.append("topgg_requests_in_flight{route=\"" + endpoint.route + "\",method=\"" + endpoint.method + "\"} " + std::to_string(endpoint.in_flight) + "\n");
+  }
+
+  output.append("# HELP topgg_response_bytes_total Size of every Top.gg API response body received.\n# TYPE topgg_response_bytes_total counter\n");
+
+  for (const auto& endpoint: endpoints) {
+    output.append("topgg_response_bytes_total{route=\"" + endpoint.route + "\",method=\"" + endpoint.method + "\"} " + std::to_string(endpoint.bytes_received) + "\n");
+  }
+
+  return output;
+}
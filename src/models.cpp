@@ -1,166 +1,935 @@
 #include <topgg/topgg.h>
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <charconv>
+#include <cctype>
+
 using topgg::account;
 using topgg::bot;
 using topgg::stats;
 using topgg::user;
 using topgg::user_socials;
+using topgg::voter;
+using topgg::voter_list;
+using topgg::voter_view;
+using topgg::vote_event;
+
+/**
+ * Non-throwing lookups for optional fields.
+ * A field is only read if it exists and holds the expected JSON type, so missing or null fields never throw.
+ */
+template<typename T>
+struct json_type {
+  static bool matches(const dpp::json& j) noexcept {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return j.is_string();
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return j.is_boolean();
+    } else {
+      static_assert(std::is_unsigned_v<T>);
+
+      return j.is_number();
+    }
+  }
+};
+
+template<typename T>
+struct json_type<std::vector<T>> {
+  static bool matches(const dpp::json& j) noexcept {
+    if (!j.is_array()) {
+      return false;
+    }
+
+    for (const auto& element: j) {
+      if (!json_type<T>::matches(element)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+template<typename T>
+static const dpp::json* find_field(const dpp::json& j, const char* key) noexcept {
+  const auto it = j.find(key);
+
+  if (it == j.end() || !json_type<T>::matches(*it)) {
+    return nullptr;
+  }
+
+  return &*it;
+}
+
+/**
+ * A single JSON field of a model: its key, whether it must be present, and how it's read from and written to JSON.
+ * read returns false if the value doesn't have the expected type, in which case the member is left untouched.
+ * write appends the member's JSON value, and returns false without appending anything if it's an empty optional.
+ */
+template<typename T>
+struct field_descriptor {
+  std::string_view name;
+  bool required;
+  bool (*read)(T& object, const dpp::json& value);
+  bool (*write)(const T& object, std::string& out);
+};
+
+template<typename V>
+static bool read_value(V& out, const dpp::json& value) {
+  if constexpr (std::is_same_v<V, dpp::snowflake>) {
+    if (!value.is_string()) {
+      return false;
+    }
+
+    out = dpp::snowflake{value.template get_ref<const std::string&>()};
+  } else if constexpr (std::is_same_v<V, std::vector<dpp::snowflake>>) {
+    if (!json_type<std::vector<std::string>>::matches(value)) {
+      return false;
+    }
+
+    out.reserve(value.size());
+
+    for (const auto& element: value) {
+      out.push_back(dpp::snowflake{element.template get_ref<const std::string&>()});
+    }
+  } else {
+    if (!json_type<V>::matches(value)) {
+      return false;
+    }
+
+    value.get_to(out);
+  }
+
+  return true;
+}
+
+template<typename V>
+static bool read_value(std::optional<V>& out, const dpp::json& value) {
+  V inner{};
+
+  if (!read_value(inner, value)) {
+    return false;
+  }
+
+  out = std::optional{std::move(inner)};
+
+  return true;
+}
+
+static constexpr char hex_digits[] = "0123456789abcdef";
+
+/**
+ * Escapes a string the same way dpp::json::dump() does.
+ */
+static void write_string(const std::string_view value, std::string& out) {
+  out.push_back('"');
+
+  for (const auto c: value) {
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+
+      case '\\':
+        out.append("\\\\");
+        break;
+
+      case '\b':
+        out.append("\\b");
+        break;
+
+      case '\f':
+        out.append("\\f");
+        break;
+
+      case '\n':
+        out.append("\\n");
+        break;
+
+      case '\r':
+        out.append("\\r");
+        break;
+
+      case '\t':
+        out.append("\\t");
+        break;
+
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out.append("\\u00");
+          out.push_back(hex_digits[static_cast<unsigned char>(c) >> 4]);
+          out.push_back(hex_digits[c & 0xf]);
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+
+  out.push_back('"');
+}
+
+static void write_number(const uint64_t value, std::string& out) {
+  char digits[20];
+  const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+
+  out.append(digits, end);
+}
+
+template<typename V>
+static bool write_value(const V& value, std::string& out) {
+  if constexpr (std::is_same_v<V, dpp::snowflake>) {
+    out.push_back('"');
+    write_number(static_cast<uint64_t>(value), out);
+    out.push_back('"');
+  } else if constexpr (std::is_same_v<V, std::string>) {
+    write_string(value, out);
+  } else if constexpr (std::is_same_v<V, bool>) {
+    out.append(value ? "true" : "false");
+  } else {
+    static_assert(std::is_unsigned_v<V>);
+
+    write_number(value, out);
+  }
+
+  return true;
+}
+
+template<typename V>
+static bool write_value(const std::vector<V>& value, std::string& out) {
+  out.push_back('[');
+
+  for (size_t i = 0; i < value.size(); i++) {
+    if (i != 0) {
+      out.push_back(',');
+    }
+
+    write_value(value[i], out);
+  }
+
+  out.push_back(']');
+
+  return true;
+}
+
+template<typename V>
+static bool write_value(const std::optional<V>& value, std::string& out) {
+  return value.has_value() && write_value(value.value(), out);
+}
+
+template<typename T, auto Member>
+static bool read_member(T& object, const dpp::json& value) {
+  return read_value(object.*Member, value);
+}
+
+/**
+ * Empty strings are treated as missing.
+ */
+template<typename T, auto Member>
+static bool read_non_empty(T& object, const dpp::json& value) {
+  if (!value.is_string() || value.template get_ref<const std::string&>().empty()) {
+    return false;
+  }
+
+  object.*Member = std::optional{value.template get<std::string>()};
+
+  return true;
+}
+
+template<typename T, auto Member>
+static bool write_member(const T& object, std::string& out) {
+  return write_value(object.*Member, out);
+}
+
+template<typename T, auto Member>
+static constexpr field_descriptor<T> required_field(const std::string_view name) noexcept {
+  return field_descriptor<T>{name, true, &read_member<T, Member>, &write_member<T, Member>};
+}
+
+template<typename T, auto Member>
+static constexpr field_descriptor<T> optional_field(const std::string_view name) noexcept {
+  return field_descriptor<T>{name, false, &read_member<T, Member>, &write_member<T, Member>};
+}
+
+template<typename T, auto Member>
+static constexpr field_descriptor<T> non_empty_field(const std::string_view name) noexcept {
+  return field_descriptor<T>{name, false, &read_non_empty<T, Member>, &write_member<T, Member>};
+}
+
+template<typename T>
+static constexpr field_descriptor<T> custom_field(const std::string_view name, bool (*read)(T&, const dpp::json&), const bool required = false) noexcept {
+  return field_descriptor<T>{name, required, read, nullptr};
+}
+
+template<typename T, size_t N>
+static constexpr bool is_sorted_by_name(const std::array<field_descriptor<T>, N>& fields) noexcept {
+  for (size_t i = 1; i < N; i++) {
+    if (!(fields[i - 1].name < fields[i].name)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * The bit set in deserialize()'s return value if the given field was read.
+ */
+template<typename T>
+static constexpr uint64_t field_bit(const std::string_view name) noexcept {
+  const auto& fields = topgg::model_schema<T>::fields;
+
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (fields[i].name == name) {
+      return uint64_t{1} << i;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * dpp::json objects are ordered maps, so their keys are walked alongside the sorted schema in a single pass, without looking any key up.
+ * Returns a bit set of the fields that were read.
+ */
+template<typename T>
+static uint64_t deserialize(const dpp::json& j, T& object) {
+  constexpr const auto& fields = topgg::model_schema<T>::fields;
+
+  static_assert(fields.size() <= 64, "A schema can't have more than 64 fields.");
+  static_assert(is_sorted_by_name(fields), "A schema's fields must be sorted by name.");
+  static_assert(std::is_same_v<typename dpp::json::object_t::key_compare, dpp::json::object_comparator_t>, "dpp::json objects must be ordered by key.");
+
+  if (!j.is_object()) {
+    throw std::invalid_argument{"Expected a JSON object."};
+  }
+
+  uint64_t read = 0;
+  size_t index = 0;
+
+  for (auto it = j.begin(); it != j.end() && index < fields.size(); ++it) {
+    const std::string_view key{it.key()};
+
+    while (index < fields.size() && fields[index].name < key) {
+      index++;
+    }
+
+    if (index < fields.size() && fields[index].name == key && fields[index].read(object, it.value())) {
+      read |= uint64_t{1} << index;
+    }
+  }
+
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (fields[i].required && (read & (uint64_t{1} << i)) == 0) {
+      throw std::invalid_argument{"Missing or invalid \"" + std::string{fields[i].name} + "\" field."};
+    }
+  }
+
+  return read;
+}
+
+/**
+ * Writes a model straight to JSON text, without building a dpp::json first. The output is identical to dpp::json::dump()'s since the schema is sorted by key.
+ * Appends to out, whose capacity is kept across calls.
+ */
+template<typename T>
+static void serialize(const T& object, std::string& out) {
+  out.push_back('{');
+
+  const auto start = out.size();
+
+  for (const auto& field: topgg::model_schema<T>::fields) {
+    if (field.write == nullptr) {
+      continue;
+    }
+
+    const auto rollback = out.size();
+
+    if (rollback != start) {
+      out.push_back(',');
+    }
+
+    out.push_back('"');
+    out.append(field.name);
+    out.append("\":");
+
+    if (!field.write(object, out)) {
+      out.resize(rollback);
+    }
+  }
+
+  out.push_back('}');
+}
+
+/**
+ * Reads exactly count digits.
+ */
+static bool parse_digits(std::string_view& input, const size_t count, int& value) noexcept {
+  if (input.size() < count) {
+    return false;
+  }
+
+  value = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const auto c = input[i];
+
+    if (c < '0' || c > '9') {
+      return false;
+    }
+
+    value = value * 10 + (c - '0');
+  }
+
+  input.remove_prefix(count);
+
+  return true;
+}
+
+static bool parse_separator(std::string_view& input, const char separator) noexcept {
+  if (input.empty() || input.front() != separator) {
+    return false;
+  }
+
+  input.remove_prefix(1);
+
+  return true;
+}
+
+/**
+ * The amount of days between 1970-01-01 and the given date in the proleptic Gregorian calendar.
+ * See https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+ */
+static int64_t days_from_civil(int64_t year, const int month, const int day) noexcept {
+  year -= month <= 2;
+
+  const auto era = (year >= 0 ? year : year - 399) / 400;
+  const auto year_of_era = year - era * 400;
+  const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+  return era * 146097 + day_of_era - 719468;
+}
+
+static int days_in_month(const int year, const int month) noexcept {
+  static constexpr int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+  if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+    return 29;
+  }
+
+  return days[month - 1];
+}
+
+/**
+ * Parses a YYYY-MM-DDTHH:MM:SS timestamp, optionally followed by fractional seconds and a Z, +HH:MM or -HH:MM offset, into a UTC unix timestamp.
+ * Timestamps without an offset are read as UTC. Fractional seconds are truncated.
+ * Unlike strptime and mktime, this doesn't allocate, take any lock or depend on the local timezone.
+ */
+static bool parse_iso8601(std::string_view input, time_t& out) noexcept {
+  int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+
+  if (!parse_digits(input, 4, year) || !parse_separator(input, '-') || !parse_digits(input, 2, month) || !parse_separator(input, '-') || !parse_digits(input, 2, day) ||
+      (!parse_separator(input, 'T') && !parse_separator(input, 't') && !parse_separator(input, ' ')) || !parse_digits(input, 2, hour) || !parse_separator(input, ':') ||
+      !parse_digits(input, 2, minute) || !parse_separator(input, ':') || !parse_digits(input, 2, second)) {
+    return false;
+  }
+
+  if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month) || hour > 23 || minute > 59 || second > 60) {
+    return false;
+  }
+
+  if (parse_separator(input, '.') || parse_separator(input, ',')) {
+    const auto digits = std::min(input.find_first_not_of("0123456789"), input.size());
+
+    if (digits == 0) {
+      return false;
+    }
+
+    input.remove_prefix(digits);
+  }
+
+  int64_t offset = 0;
+
+  if (!input.empty()) {
+    const auto sign = input.front();
+
+    if (sign == 'Z' || sign == 'z') {
+      input.remove_prefix(1);
+    } else if (sign == '+' || sign == '-') {
+      int offset_hours = 0, offset_minutes = 0;
+
+      input.remove_prefix(1);
+
+      if (!parse_digits(input, 2, offset_hours)) {
+        return false;
+      }
+
+      parse_separator(input, ':');
+
+      if (!parse_digits(input, 2, offset_minutes) || offset_hours > 23 || offset_minutes > 59) {
+        return false;
+      }
+
+      offset = (offset_hours * 3600 + offset_minutes * 60) * (sign == '-' ? -1 : 1);
+    } else {
+      return false;
+    }
+
+    if (!input.empty()) {
+      return false;
+    }
+  }
+
+  out = static_cast<time_t>(days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset);
+
+  return true;
+}
+
+static constexpr uint8_t avatar_present = 1;
+static constexpr uint8_t avatar_animated = 2;
+static constexpr uint8_t avatar_raw = 4;
+
+static int hex_value(const char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  return -1;
+}
+
+static std::string avatar_url(const dpp::snowflake id, const std::optional<std::string_view>& hash, const uint16_t size, const topgg::avatar_format format) {
+  if (size < 16 || size > 4096 || (size & (size - 1)) != 0) {
+    throw std::invalid_argument{"Avatar size must be a power of two between 16 and 4096."};
+  }
+
+  if (!hash.has_value()) {
+    return "https://cdn.discordapp.com/embed/avatars/" + std::to_string((id >> 22) % 5) + ".png";
+  }
+
+  const auto animated = hash->rfind("a_", 0) == 0;
+  const char* ext = "png";
+
+  if (format == topgg::avatar_format::webp) {
+    ext = "webp";
+  } else if (animated && (format == topgg::avatar_format::automatic || format == topgg::avatar_format::gif)) {
+    ext = "gif";
+  }
+
+  char id_str[20];
+  const auto id_end = std::to_chars(id_str, id_str + sizeof(id_str), static_cast<uint64_t>(id)).ptr;
+
+  char size_str[5];
+  const auto size_end = std::to_chars(size_str, size_str + sizeof(size_str), size).ptr;
+
+  std::string url{};
+  url.reserve(64 + hash->size());
+
+  url.append("https://cdn.discordapp.com/avatars/").append(id_str, id_end).push_back('/');
+  url.append(hash.value()).push_back('.');
+  url.append(ext).append("?size=").append(size_str, size_end);
+
+  return url;
+}
 
-#ifdef _WIN32
-#include <sstream>
-#include <iomanip>
-
-static void strptime(const char* s, const char* f, tm* t) {
-  std::istringstream input{s};
-  input.imbue(std::locale{setlocale(LC_ALL, nullptr)});
-  input >> std::get_time(t, f);
-}
-
-#ifdef _MSC_VER
-#pragma warning(disable: 4101)
-#endif
-#endif
-
-#define SERIALIZE_PRIVATE_OPTIONAL(j, name) \
-  if (m_##name.has_value()) {               \
-    j[#name] = m_##name.value();            \
-  }
-
-#define DESERIALIZE(j, name, type) \
-  name = j[#name].template get<type>()
-
-#define DESERIALIZE_ALIAS(j, name, prop, type) \
-  prop = j[#name].template get<type>()
-
-#define IGNORE_EXCEPTION(scope) \
-  try scope catch (TOPGG_UNUSED const std::exception&) {}
-
-#define DESERIALIZE_VECTOR(j, name, type)                  \
-  IGNORE_EXCEPTION({                                       \
-    name = j[#name].template get<std::vector<type>>();     \
-  })
-
-#define DESERIALIZE_VECTOR_ALIAS(j, name, prop, type)      \
-  IGNORE_EXCEPTION({                                       \
-    prop = j[#name].template get<std::vector<type>>();     \
-  })
-
-#define DESERIALIZE_OPTIONAL(j, name, type)   \
-  IGNORE_EXCEPTION({                          \
-    name = j[#name].template get<type>();     \
-  })
-
-#define DESERIALIZE_PRIVATE_OPTIONAL(j, name, type)   \
-  IGNORE_EXCEPTION({                                  \
-    m_##name = j[#name].template get<type>();         \
-  })
-
-#define DESERIALIZE_OPTIONAL_ALIAS(j, name, prop) \
-  IGNORE_EXCEPTION({                              \
-    prop = j[#name].template get<type>();         \
-  })
-
-#define DESERIALIZE_OPTIONAL_STRING(j, name)                      \
-  IGNORE_EXCEPTION({                                              \
-    const auto value = j[#name].template get<std::string>(); \
-                                                                  \
-    if (value.size() > 0) {                                       \
-      name = std::optional{value};                                \
-    }                                                             \
-  })
-
-#define DESERIALIZE_OPTIONAL_STRING_ALIAS(j, name, prop)          \
-  IGNORE_EXCEPTION({                                              \
-    const auto value = j[#name].template get<std::string>(); \
-                                                                  \
-    if (value.size() > 0) {                                       \
-      prop = std::optional{value};                                \
-    }                                                             \
-  })
+/**
+ * Discord avatar hashes are 32 hexadecimal digits, optionally prefixed with a_ if they're animated.
+ * These are packed into 16 bytes, and anything else is kept as is. An empty hash means no avatar, like it does for voter_view.
+ */
+void account::set_avatar_hash(const std::optional<std::string_view>& hash) {
+  m_avatar_flags = 0;
+  m_raw_avatar_hash.clear();
+
+  if (!hash.has_value() || hash->empty()) {
+    return;
+  }
+
+  m_avatar_flags = avatar_present;
+
+  auto digits = hash.value();
+
+  if (digits.rfind("a_", 0) == 0) {
+    m_avatar_flags |= avatar_animated;
+    digits.remove_prefix(2);
+  }
+
+  if (digits.size() == m_avatar_hash.size() * 2) {
+    size_t i = 0;
+
+    for (; i < m_avatar_hash.size(); i++) {
+      const auto high = hex_value(digits[i * 2]);
+      const auto low = hex_value(digits[i * 2 + 1]);
+
+      if (high < 0 || low < 0) {
+        break;
+      }
+
+      m_avatar_hash[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+
+    if (i == m_avatar_hash.size()) {
+      return;
+    }
+  }
+
+  m_avatar_flags |= avatar_raw;
+  m_raw_avatar_hash.assign(hash.value());
+}
+
+std::optional<std::string> account::avatar_hash() const {
+  if ((m_avatar_flags & avatar_present) == 0) {
+    return std::nullopt;
+  } else if ((m_avatar_flags & avatar_raw) != 0) {
+    return std::optional{m_raw_avatar_hash};
+  }
+
+  std::string hash{};
+  hash.reserve(34);
+
+  if ((m_avatar_flags & avatar_animated) != 0) {
+    hash.append("a_");
+  }
+
+  for (const auto byte: m_avatar_hash) {
+    hash.push_back(hex_digits[byte >> 4]);
+    hash.push_back(hex_digits[byte & 15]);
+  }
+
+  return std::optional{hash};
+}
+
+bool account::has_animated_avatar() const noexcept {
+  return (m_avatar_flags & avatar_animated) != 0;
+}
+
+std::string account::avatar(const uint16_t size, const topgg::avatar_format format) const {
+  if ((m_avatar_flags & avatar_present) == 0) {
+    return avatar_url(id, std::nullopt, size, format);
+  } else if ((m_avatar_flags & avatar_raw) != 0) {
+    return avatar_url(id, std::optional<std::string_view>{m_raw_avatar_hash}, size, format);
+  }
+
+  char hash[34];
+  size_t length = 0;
+
+  if ((m_avatar_flags & avatar_animated) != 0) {
+    hash[length++] = 'a';
+    hash[length++] = '_';
+  }
+
+  for (const auto byte: m_avatar_hash) {
+    hash[length++] = hex_digits[byte >> 4];
+    hash[length++] = hex_digits[byte & 15];
+  }
+
+  return avatar_url(id, std::optional<std::string_view>{std::string_view{hash, length}}, size, format);
+}
 
 account::account(const dpp::json& j) {
   id = dpp::snowflake{j["id"].template get<std::string>()};
 
-  DESERIALIZE(j, username, std::string);
+  username = j["username"].template get<std::string>();
+
+  const auto j_avatar = find_field<std::string>(j, "avatar");
+
+  set_avatar_hash(j_avatar ? std::optional<std::string_view>{j_avatar->template get_ref<const std::string&>()} : std::nullopt);
+  created_at = static_cast<time_t>(((id >> 22) / 1000) + 1420070400);
+}
+
+account::account(const dpp::snowflake id_in, std::string&& username_in, const std::optional<std::string_view>& avatar_hash)
+  : id(id_in), username(std::move(username_in)), created_at(static_cast<time_t>(((id_in >> 22) / 1000) + 1420070400)) {
+  set_avatar_hash(avatar_hash);
+}
+
+/**
+ * A SAX handler that reads voters straight from the /bots/votes response body,
+ * without materializing the whole response as a dpp::json DOM first.
+ *
+ * Strings are swapped with the parser's token buffer instead of being copied, so that neither side reallocates once warmed up.
+ * Every complete voter is handed to the sink as (id, username, avatar hash or nullptr), which returns false to stop parsing early.
+ */
+template<typename Sink>
+class voters_sax {
+  enum class field { none, id, username, avatar };
 
-  try {
-    const auto hash = j["avatar"].template get<std::string>();
-    const char* ext = hash.rfind("a_", 0) == 0 ? "gif" : "png";
+  Sink& m_sink;
+  size_t m_depth;
+  field m_field;
+  std::optional<dpp::snowflake> m_id;
+  std::string m_username;
+  std::string m_avatar;
+  bool m_has_avatar;
 
-    avatar = "https://cdn.discordapp.com/avatars/" + std::to_string(id) + "/" + hash + "." + ext + "?size=1024";
-  } catch (TOPGG_UNUSED const std::exception&) {
-    avatar = "https://cdn.discordapp.com/embed/avatars/" + std::to_string((id >> 22) % 5) + ".png";
+  inline bool in_voter() const noexcept {
+    return m_depth == 2;
   }
 
-  created_at = static_cast<time_t>(((id >> 22) / 1000) + 1420070400);
+public:
+  inline voters_sax(Sink& sink)
+    : m_sink(sink), m_depth(0), m_field(field::none), m_has_avatar(false) {}
+
+  bool null() {
+    m_field = field::none;
+
+    return true;
+  }
+
+  bool boolean(TOPGG_UNUSED bool value) {
+    return null();
+  }
+
+  bool number_integer(TOPGG_UNUSED dpp::json::number_integer_t value) {
+    return null();
+  }
+
+  bool number_unsigned(dpp::json::number_unsigned_t value) {
+    if (in_voter() && m_field == field::id) {
+      m_id = dpp::snowflake{value};
+    }
+
+    return null();
+  }
+
+  bool number_float(TOPGG_UNUSED dpp::json::number_float_t value, TOPGG_UNUSED const dpp::json::string_t& raw) {
+    return null();
+  }
+
+  bool string(dpp::json::string_t& value) {
+    if (in_voter()) {
+      switch (m_field) {
+      case field::id:
+        m_id = dpp::snowflake{value};
+        break;
+
+      case field::username:
+        m_username.swap(value);
+        break;
+
+      case field::avatar:
+        m_avatar.swap(value);
+        m_has_avatar = true;
+        break;
+
+      default:
+        break;
+      }
+    }
+
+    return null();
+  }
+
+  bool binary(TOPGG_UNUSED dpp::json::binary_t& value) {
+    return null();
+  }
+
+  bool start_object(TOPGG_UNUSED size_t elements) {
+    if (++m_depth == 2) {
+      m_id.reset();
+      m_username.clear();
+      m_has_avatar = false;
+    }
+
+    return null();
+  }
+
+  bool key(dpp::json::string_t& name) {
+    if (!in_voter()) {
+      m_field = field::none;
+    } else if (name == "id") {
+      m_field = field::id;
+    } else if (name == "username") {
+      m_field = field::username;
+    } else if (name == "avatar") {
+      m_field = field::avatar;
+    } else {
+      m_field = field::none;
+    }
+
+    return true;
+  }
+
+  bool end_object() {
+    if (in_voter() && m_id.has_value() && !m_sink(m_id.value(), m_username, m_has_avatar ? &m_avatar : nullptr)) {
+      return false;
+    }
+
+    m_depth--;
+
+    return null();
+  }
+
+  bool start_array(TOPGG_UNUSED size_t elements) {
+    m_depth++;
+
+    return null();
+  }
+
+  bool end_array() {
+    m_depth--;
+
+    return null();
+  }
+
+  template<class E>
+  bool parse_error(TOPGG_UNUSED size_t position, TOPGG_UNUSED const std::string& last_token, const E& ex) {
+    throw ex;
+  }
+};
+
+template<typename Sink>
+static void parse_voters(const std::string& body, Sink&& sink) {
+  voters_sax<Sink> sax{sink};
+  dpp::json::sax_parse(body, &sax);
 }
 
-bot::bot(const dpp::json& j)
-  : account(j), url("https://top.gg/bot/") {
-  DESERIALIZE(j, discriminator, std::string);
-  DESERIALIZE(j, prefix, std::string);
-  DESERIALIZE_ALIAS(j, shortdesc, short_description, std::string);
-  DESERIALIZE_OPTIONAL_STRING_ALIAS(j, longdesc, long_description);
-  DESERIALIZE_VECTOR(j, tags, std::string);
-  DESERIALIZE_OPTIONAL_STRING(j, website);
-  DESERIALIZE_OPTIONAL_STRING(j, github);
+/**
+ * Every voter is a JSON object, so the amount of opening braces is an upper bound of the amount of voters.
+ */
+static size_t max_voters_in(const std::string& body) {
+  return static_cast<size_t>(std::count(body.begin(), body.end(), '{'));
+}
 
-  IGNORE_EXCEPTION({
-    const auto j_owners = j["owners"].template get<std::vector<std::string>>();
+std::vector<voter> voter::parse_list(const std::string& body) {
+  std::vector<voter> voters{};
+  voters.reserve(max_voters_in(body));
 
-    owners.reserve(j_owners.size());
+  parse_voters(body, [&voters](const dpp::snowflake id, std::string& username, const std::string* avatar_hash) {
+    voters.push_back(voter{id, std::move(username), avatar_hash ? std::optional<std::string_view>{*avatar_hash} : std::nullopt});
 
-    for (const auto& owner: j_owners) {
-      owners.push_back(dpp::snowflake{owner});
+    return true;
+  });
+
+  return voters;
+}
+
+void voter::scan_list(const std::string& body, const std::function<bool(const dpp::snowflake, std::string&, const std::string*)>& fn) {
+  parse_voters(body, fn);
+}
+
+/**
+ * Usernames and avatar hashes are appended to a single buffer instead of being stored as separate strings.
+ * The decoded strings are stored rather than offsets into the response body itself, since JSON escapes make the raw body differ from the decoded text.
+ */
+voter_list voter_list::parse(const std::string& body) {
+  voter_list list{};
+  list.m_entries.reserve(max_voters_in(body));
+  list.m_buffer.reserve(body.size() / 2);
+
+  parse_voters(body, [&list](const dpp::snowflake id, const std::string& username, const std::string* avatar_hash) {
+    entry e{id, static_cast<uint32_t>(list.m_buffer.size()), static_cast<uint32_t>(username.size()), 0, 0};
+
+    list.m_buffer.append(username);
+
+    if (avatar_hash != nullptr) {
+      e.avatar_offset = static_cast<uint32_t>(list.m_buffer.size());
+      e.avatar_length = static_cast<uint32_t>(avatar_hash->size());
+
+      list.m_buffer.append(*avatar_hash);
     }
+
+    list.m_entries.push_back(e);
+
+    return true;
   });
 
-  DESERIALIZE_VECTOR(j, guilds, size_t);
-  DESERIALIZE_OPTIONAL_STRING_ALIAS(j, bannerUrl, banner);
+  list.m_buffer.shrink_to_fit();
 
-  const auto j_approved_at = j["date"].template get<std::string>();
-  tm approved_at_tm;
+  return list;
+}
 
-  strptime(j_approved_at.data(), "%Y-%m-%dT%H:%M:%S", &approved_at_tm);
-  approved_at = mktime(&approved_at_tm);
+std::string voter_view::avatar(const uint16_t size, const topgg::avatar_format format) const {
+  return avatar_url(id, avatar_hash.empty() ? std::nullopt : std::optional{avatar_hash}, size, format);
+}
 
-  DESERIALIZE_ALIAS(j, certifiedBot, is_certified, bool);
-  DESERIALIZE_VECTOR(j, shards, size_t);
-  DESERIALIZE_ALIAS(j, points, votes, size_t);
-  DESERIALIZE_ALIAS(j, monthlyPoints, monthly_votes, size_t);
+time_t voter_view::created_at() const noexcept {
+  return static_cast<time_t>(((id >> 22) / 1000) + 1420070400);
+}
 
-  try {
-    DESERIALIZE(j, invite, std::string);
-  } catch (TOPGG_UNUSED const std::exception&) {
-    invite = "https://discord.com/oauth2/authorize?scope=bot&client_id=" + std::to_string(id);
+voter voter_view::to_voter() const {
+  return voter{id, std::string{username}, avatar_hash.empty() ? std::nullopt : std::optional{avatar_hash}};
+}
+
+template<>
+struct topgg::model_schema<bot> {
+  static bool read_date(bot& b, const dpp::json& value) {
+    return value.is_string() && parse_iso8601(value.template get_ref<const std::string&>(), b.approved_at);
   }
 
-  IGNORE_EXCEPTION({
-    const auto j_support = j["support"].template get<std::string>();
+  static bool read_support(bot& b, const dpp::json& value) {
+    if (!value.is_string() || value.template get_ref<const std::string&>().empty()) {
+      return false;
+    }
+
+    b.support = std::optional{"https://discord.com/invite/" + value.template get_ref<const std::string&>()};
 
-    if (j_support.size() > 0) {
-      support = std::optional{"https://discord.com/invite/" + j_support};
+    return true;
+  }
+
+  static bool read_vanity(bot& b, const dpp::json& value) {
+    if (!value.is_string()) {
+      return false;
     }
-  });
 
-  try {
-    DESERIALIZE(j, shard_count, size_t);
-  } catch (TOPGG_UNUSED const std::exception&) {
+    b.url.append(value.template get_ref<const std::string&>());
+
+    return true;
+  }
+
+  static constexpr std::array<field_descriptor<bot>, 19> fields{{
+    non_empty_field<bot, &bot::banner>("bannerUrl"),
+    required_field<bot, &bot::is_certified>("certifiedBot"),
+    custom_field<bot>("date", &read_date, true),
+    required_field<bot, &bot::discriminator>("discriminator"),
+    non_empty_field<bot, &bot::github>("github"),
+    optional_field<bot, &bot::guilds>("guilds"),
+    optional_field<bot, &bot::invite>("invite"),
+    non_empty_field<bot, &bot::long_description>("longdesc"),
+    required_field<bot, &bot::monthly_votes>("monthlyPoints"),
+    optional_field<bot, &bot::owners>("owners"),
+    required_field<bot, &bot::votes>("points"),
+    required_field<bot, &bot::prefix>("prefix"),
+    optional_field<bot, &bot::shard_count>("shard_count"),
+    optional_field<bot, &bot::shards>("shards"),
+    required_field<bot, &bot::short_description>("shortdesc"),
+    custom_field<bot>("support", &read_support),
+    optional_field<bot, &bot::tags>("tags"),
+    custom_field<bot>("vanity", &read_vanity),
+    non_empty_field<bot, &bot::website>("website"),
+  }};
+};
+
+bot::bot(const dpp::json& j)
+  : account(j), approved_at(0), is_certified(false), votes(0), monthly_votes(0), shard_count(0), url("https://top.gg/bot/") {
+  const auto read = deserialize(j, *this);
+
+  if ((read & field_bit<bot>("invite")) == 0) {
+    invite = "https://discord.com/oauth2/authorize?scope=bot&client_id=" + std::to_string(id);
+  }
+
+  if ((read & field_bit<bot>("shard_count")) == 0) {
     shard_count = shards.size();
   }
 
-  try {
-    url.append(j["vanity"].template get<std::string>());
-  } catch (TOPGG_UNUSED const std::exception&) {
+  if ((read & field_bit<bot>("vanity")) == 0) {
     url.append(std::to_string(id));
   }
 }
 
+template<>
+struct topgg::model_schema<stats> {
+  static constexpr std::array<field_descriptor<stats>, 4> fields{{
+    optional_field<stats, &stats::m_server_count>("server_count"),
+    optional_field<stats, &stats::m_shard_count>("shard_count"),
+    optional_field<stats, &stats::m_shard_id>("shard_id"),
+    optional_field<stats, &stats::m_shards>("shards"),
+  }};
+};
+
 stats::stats(const dpp::json& j) {
-  DESERIALIZE_PRIVATE_OPTIONAL(j, shard_count, size_t);
-  DESERIALIZE_PRIVATE_OPTIONAL(j, server_count, size_t);
-  DESERIALIZE_PRIVATE_OPTIONAL(j, shards, std::vector<size_t>);
-  DESERIALIZE_PRIVATE_OPTIONAL(j, shard_id, size_t);
+  deserialize(j, *this);
 }
 
 stats::stats(dpp::cluster& bot) {
@@ -192,15 +961,19 @@ stats::stats(const std::vector<size_t>& shards, const size_t shard_index)
   m_shard_count = std::optional{shards.size()};
 }
 
+void stats::write_json(std::string& out) const {
+  out.clear();
+  out.reserve(80 + (m_shards.has_value() ? m_shards->size() * 21 : 0));
+
+  serialize(*this, out);
+}
+
 std::string stats::to_json() const {
-  dpp::json j;
+  std::string out{};
 
-  SERIALIZE_PRIVATE_OPTIONAL(j, shard_count);
-  SERIALIZE_PRIVATE_OPTIONAL(j, server_count);
-  SERIALIZE_PRIVATE_OPTIONAL(j, shards);
-  SERIALIZE_PRIVATE_OPTIONAL(j, shard_id);
+  write_json(out);
 
-  return j.dump();
+  return out;
 }
 
 std::vector<size_t> stats::shards() const noexcept {
@@ -215,38 +988,142 @@ std::optional<size_t> stats::server_count() const noexcept {
   if (m_server_count.has_value()) {
     return m_server_count;
   } else {
-    IGNORE_EXCEPTION({
-      const auto& shards = m_shards.value();
-
-      if (shards.size() > 0) {
-        return std::optional{std::reduce(shards.begin(), shards.end())};
-      }
-    });
+    if (m_shards.has_value() && m_shards->size() > 0) {
+      return std::optional{std::reduce(m_shards->begin(), m_shards->end())};
+    }
 
     return std::nullopt;
   }
 }
 
+template<>
+struct topgg::model_schema<user_socials> {
+  static constexpr std::array<field_descriptor<user_socials>, 5> fields{{
+    non_empty_field<user_socials, &user_socials::github>("github"),
+    non_empty_field<user_socials, &user_socials::instagram>("instagram"),
+    non_empty_field<user_socials, &user_socials::reddit>("reddit"),
+    non_empty_field<user_socials, &user_socials::twitter>("twitter"),
+    non_empty_field<user_socials, &user_socials::youtube>("youtube"),
+  }};
+};
+
 user_socials::user_socials(const dpp::json& j) {
-  DESERIALIZE_OPTIONAL_STRING(j, github);
-  DESERIALIZE_OPTIONAL_STRING(j, instagram);
-  DESERIALIZE_OPTIONAL_STRING(j, reddit);
-  DESERIALIZE_OPTIONAL_STRING(j, twitter);
-  DESERIALIZE_OPTIONAL_STRING(j, youtube);
+  deserialize(j, *this);
 }
 
+template<>
+struct topgg::model_schema<user> {
+  static bool read_socials(user& u, const dpp::json& value) {
+    if (!value.is_object()) {
+      return false;
+    }
+
+    u.socials = std::optional{user_socials{value}};
+
+    return true;
+  }
+
+  static constexpr std::array<field_descriptor<user>, 8> fields{{
+    required_field<user, &user::is_admin>("admin"),
+    non_empty_field<user, &user::banner>("banner"),
+    non_empty_field<user, &user::bio>("bio"),
+    required_field<user, &user::is_certified_dev>("certifiedDev"),
+    required_field<user, &user::is_moderator>("mod"),
+    custom_field<user>("socials", &read_socials),
+    required_field<user, &user::is_supporter>("supporter"),
+    required_field<user, &user::is_web_moderator>("webMod"),
+  }};
+};
+
 user::user(const dpp::json& j)
-  : account(j) {
-  DESERIALIZE_OPTIONAL_STRING(j, bio);
-  DESERIALIZE_OPTIONAL_STRING(j, banner);
+  : account(j), is_supporter(false), is_certified_dev(false), is_moderator(false), is_web_moderator(false), is_admin(false) {
+  deserialize(j, *this);
+}
+
+/**
+ * Decodes a query string component, where + is a space and %XX is an escaped byte. Malformed escapes are kept as-is.
+ */
+static std::string url_decode(const std::string_view input) {
+  std::string output{};
+
+  output.reserve(input.size());
+
+  for (size_t i = 0; i < input.size(); i++) {
+    const auto c = input[i];
+
+    if (c == '+') {
+      output.push_back(' ');
+    } else if (c == '%' && i + 2 < input.size()) {
+      const auto high = hex_value(static_cast<char>(std::tolower(static_cast<unsigned char>(input[i + 1]))));
+      const auto low = hex_value(static_cast<char>(std::tolower(static_cast<unsigned char>(input[i + 2]))));
+
+      if (high < 0 || low < 0) {
+        output.push_back(c);
+        continue;
+      }
+
+      output.push_back(static_cast<char>((high << 4) | low));
+      i += 2;
+    } else {
+      output.push_back(c);
+    }
+  }
+
+  return output;
+}
+
+static const std::string& required_string(const dpp::json& j, const char* key) {
+  const auto value = find_field<std::string>(j, key);
+
+  if (value == nullptr) {
+    throw std::invalid_argument{"Missing or invalid \"" + std::string{key} + "\" field."};
+  }
+
+  return value->template get_ref<const std::string&>();
+}
 
-  if (j.contains("socials")) {
-    socials = std::optional{user_socials{j["socials"].template get<dpp::json>()}};
+static dpp::snowflake required_snowflake(const dpp::json& j, const char* key) {
+  const dpp::snowflake id{required_string(j, key)};
+
+  if (id.empty()) {
+    throw std::invalid_argument{"Missing or invalid \"" + std::string{key} + "\" field."};
+  }
+
+  return id;
+}
+
+vote_event::vote_event(const dpp::json& j)
+  : receiver_id(required_snowflake(j, j.contains("guild") ? "guild" : "bot")), voter_id(required_snowflake(j, "user")),
+    is_test(required_string(j, "type") == "test"), is_weekend(false) {
+  if (const auto j_is_weekend = find_field<bool>(j, "isWeekend"); j_is_weekend) {
+    is_weekend = j_is_weekend->template get<bool>();
   }
 
-  DESERIALIZE_ALIAS(j, supporter, is_supporter, bool);
-  DESERIALIZE_ALIAS(j, certifiedDev, is_certified_dev, bool);
-  DESERIALIZE_ALIAS(j, mod, is_moderator, bool);
-  DESERIALIZE_ALIAS(j, webMod, is_web_moderator, bool);
-  DESERIALIZE_ALIAS(j, admin, is_admin, bool);
+  const auto j_query = find_field<std::string>(j, "query");
+
+  if (j_query == nullptr) {
+    return;
+  }
+
+  std::string_view remaining{j_query->template get_ref<const std::string&>()};
+
+  if (!remaining.empty() && remaining.front() == '?') {
+    remaining.remove_prefix(1);
+  }
+
+  while (!remaining.empty()) {
+    const auto separator = remaining.find('&');
+    const auto pair = remaining.substr(0, separator);
+
+    remaining = separator == std::string_view::npos ? std::string_view{} : remaining.substr(separator + 1);
+
+    if (pair.empty()) {
+      continue;
+    }
+
+    const auto equals = pair.find('=');
+    const auto key = url_decode(pair.substr(0, equals));
+
+    query.insert_or_assign(key, equals == std::string_view::npos ? std::string{} : url_decode(pair.substr(equals + 1)));
+  }
 }
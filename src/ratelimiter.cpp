@@ -0,0 +1,115 @@
+#include <topgg/topgg.h>
+
+#include <algorithm>
+
+using topgg::ratelimit_stats;
+using topgg::ratelimiter;
+
+using std::chrono::steady_clock;
+
+ratelimiter::bucket::bucket(const double capacity_in, const double period_in_seconds)
+  : tokens(capacity_in), capacity(capacity_in), refill_rate(capacity_in / period_in_seconds), last_refill(steady_clock::now()) {}
+
+bool ratelimiter::bucket::available(const steady_clock::time_point now) noexcept {
+  const std::chrono::duration<double> elapsed = now - last_refill;
+
+  tokens = std::min(capacity, tokens + elapsed.count() * refill_rate);
+  last_refill = now;
+
+  return tokens >= 1.0;
+}
+
+/**
+ * Top.gg allows 100 requests per second globally, and 60 requests per minute on the /bots routes.
+ */
+ratelimiter::ratelimiter(dpp::cluster& cluster)
+  : m_cluster(cluster), m_global(100, 1), m_bots(60, 60), m_blocked_until(steady_clock::now()), m_stats() {
+  /**
+   * Queued requests are sent from a D++ timer, which doesn't need to create extra threads.
+   */
+  m_timer = m_cluster.start_timer([this](TOPGG_UNUSED dpp::timer) {
+    drain();
+  }, 1);
+}
+
+bool ratelimiter::try_acquire(const bool is_bots_route, const steady_clock::time_point now) noexcept {
+  if (now < m_blocked_until || !m_global.available(now) || (is_bots_route && !m_bots.available(now))) {
+    return false;
+  }
+
+  m_global.tokens -= 1.0;
+
+  if (is_bots_route) {
+    m_bots.tokens -= 1.0;
+  }
+
+  return true;
+}
+
+void ratelimiter::schedule(const std::string& url, std::function<void()>&& send) {
+  const auto is_bots_route = url.rfind("/bots", 0) == 0;
+
+  {
+    std::lock_guard lock{m_mutex};
+
+    const auto now = steady_clock::now();
+
+    if (!m_queue.empty() || !try_acquire(is_bots_route, now)) {
+      m_queue.push_back(queued_request{is_bots_route, std::move(send), now});
+      m_stats.delayed++;
+      m_stats.max_queue_depth = std::max(m_stats.max_queue_depth, m_queue.size());
+
+      return;
+    }
+  }
+
+  send();
+}
+
+void ratelimiter::block(const uint16_t retry_after) {
+  std::lock_guard lock{m_mutex};
+
+  m_blocked_until = std::max(m_blocked_until, steady_clock::now() + std::chrono::seconds{retry_after});
+  m_stats.ratelimited++;
+}
+
+void ratelimiter::drain() {
+  std::vector<std::function<void()>> ready{};
+
+  {
+    std::lock_guard lock{m_mutex};
+
+    const auto now = steady_clock::now();
+
+    /**
+     * Requests are sent in the order they were queued in.
+     */
+    while (!m_queue.empty() && try_acquire(m_queue.front().is_bots_route, now)) {
+      auto& request = m_queue.front();
+      const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(now - request.queued_at);
+
+      m_stats.total_delay += delay;
+      m_stats.max_delay = std::max(m_stats.max_delay, delay);
+
+      ready.push_back(std::move(request.send));
+      m_queue.pop_front();
+    }
+  }
+
+  for (const auto& send: ready) {
+    send();
+  }
+}
+
+ratelimit_stats ratelimiter::stats() noexcept {
+  std::lock_guard lock{m_mutex};
+
+  auto snapshot = m_stats;
+  snapshot.queue_depth = m_queue.size();
+
+  return snapshot;
+}
+
+ratelimiter::~ratelimiter() {
+  m_cluster.stop_timer(m_timer);
+}
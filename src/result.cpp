@@ -1,5 +1,10 @@
 #include <topgg/topgg.h>
 
+#include <algorithm>
+#include <climits>
+
+#include <zlib.h>
+
 using dpp::json;
 
 using topgg::internal_result;
@@ -7,6 +12,7 @@ using topgg::internal_server_error;
 using topgg::invalid_token;
 using topgg::not_found;
 using topgg::ratelimited;
+using topgg::response_too_large;
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -72,7 +78,7 @@ void internal_result::prepare() const {
       throw not_found{};
 
     case 429: {
-      const auto j = json::parse(m_response.body);
+      const auto j = json::parse(body());
       const auto retry_after = j["retry_after"].template get<uint16_t>();
 
       throw ratelimited{retry_after};
@@ -82,4 +88,81 @@ void internal_result::prepare() const {
       throw internal_server_error{};
     }
   }
-}
\ No newline at end of file
+}
+/**
+ * Every thread inflates into its own buffer, which keeps its capacity between responses unless a large one made it grow past this.
+ */
+static constexpr size_t pooled_buffer_capacity = 1024 * 1024;
+
+/**
+ * JSON never starts with gzip's magic bytes, so compressed bodies are recognized without looking at the Content-Encoding header.
+ */
+static bool is_gzip(const std::string& body) noexcept {
+  return body.size() >= 2 && static_cast<unsigned char>(body[0]) == 0x1f && static_cast<unsigned char>(body[1]) == 0x8b;
+}
+
+const std::string& internal_result::decode(const std::string& body, const size_t max_size) {
+  if (body.size() > max_size) {
+    throw response_too_large{max_size};
+  } else if (!is_gzip(body)) {
+    return body;
+  } else if (body.size() > UINT_MAX) {
+    throw internal_server_error{};
+  }
+
+  static thread_local std::string buffer{};
+
+  if (buffer.capacity() > pooled_buffer_capacity) {
+    std::string{}.swap(buffer);
+  }
+
+  z_stream stream{};
+
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    throw internal_server_error{};
+  }
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+  stream.avail_in = static_cast<uInt>(body.size());
+
+  /**
+   * JSON usually compresses about five to ten times, so most bodies are inflated without growing the buffer more than once.
+   */
+  buffer.resize(std::min(max_size, std::max<size_t>({buffer.capacity(), body.size() * 8, 16384})));
+
+  size_t written = 0;
+  auto status = Z_OK;
+
+  while (status != Z_STREAM_END) {
+    if (written == buffer.size()) {
+      if (written == max_size) {
+        inflateEnd(&stream);
+
+        throw response_too_large{max_size};
+      }
+
+      buffer.resize(std::min(max_size, buffer.size() * 2));
+    }
+
+    const auto available = static_cast<uInt>(std::min<size_t>(buffer.size() - written, UINT_MAX));
+
+    stream.next_out = reinterpret_cast<Bytef*>(buffer.data() + written);
+    stream.avail_out = available;
+    status = inflate(&stream, Z_NO_FLUSH);
+    written += available - stream.avail_out;
+
+    /**
+     * Z_BUF_ERROR only means that no progress was possible, which is an error if there's no more input left to read.
+     */
+    if ((status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) || (status == Z_BUF_ERROR && stream.avail_in == 0)) {
+      inflateEnd(&stream);
+
+      throw internal_server_error{};
+    }
+  }
+
+  inflateEnd(&stream);
+  buffer.resize(written);
+
+  return buffer;
+}
@@ -0,0 +1,271 @@
+#include <topgg/topgg.h>
+
+#include <algorithm>
+#include <ctime>
+
+using topgg::vote_tracker;
+
+/**
+ * A user can only vote again after 12 hours.
+ */
+static constexpr time_t vote_cooldown = 43200;
+
+/**
+ * The amount of newest voters remembered from the previous poll, used to find where new votes end.
+ */
+static constexpr size_t head_length = 8;
+
+static constexpr size_t npos = static_cast<size_t>(-1);
+
+namespace {
+  /**
+   * Finds where the previous poll's newest voters begin in a newest-first voter list.
+   *
+   * Those voters should appear in the same order after every new vote. A voter who voted again is moved to the top instead,
+   * so previous head entries that already appeared above the boundary are skipped while matching.
+   */
+  class boundary_finder {
+    const std::vector<dpp::snowflake>& m_head;
+    std::vector<bool> m_moved;
+    std::vector<size_t> m_matched;
+
+    size_t next_unmoved(size_t from) const noexcept {
+      while (from < m_head.size() && m_moved[from]) {
+        from++;
+      }
+
+      return from;
+    }
+
+  public:
+    size_t match_start;
+
+    inline boundary_finder(const std::vector<dpp::snowflake>& head)
+      : m_head(head), m_moved(head.size(), false), match_start(npos) {}
+
+    /**
+     * Returns true once the entire previous head has been matched.
+     */
+    bool feed(const dpp::snowflake id, const size_t index) {
+      if (match_start != npos) {
+        const auto expected = next_unmoved(m_matched.back() + 1);
+
+        if (expected < m_head.size() && id == m_head[expected]) {
+          m_matched.push_back(expected);
+
+          return next_unmoved(expected + 1) == m_head.size();
+        }
+
+        for (const auto h: m_matched) {
+          m_moved[h] = true;
+        }
+
+        m_matched.clear();
+        match_start = npos;
+      }
+
+      const auto first = next_unmoved(0);
+
+      if (first < m_head.size() && id == m_head[first]) {
+        match_start = index;
+        m_matched.push_back(first);
+
+        return next_unmoved(first + 1) == m_head.size();
+      }
+
+      const auto found = std::find(m_head.begin(), m_head.end(), id);
+
+      if (found != m_head.end()) {
+        m_moved[static_cast<size_t>(found - m_head.begin())] = true;
+      }
+
+      return false;
+    }
+  };
+} // namespace
+
+vote_tracker::delta vote_tracker::state::scan(const std::string& body) {
+  std::lock_guard lock{mutex};
+
+  const auto now = std::time(nullptr);
+  std::vector<dpp::snowflake> ids{};
+  std::vector<voter> voters{};
+  boundary_finder finder{head};
+
+  expire(now);
+
+  /**
+   * Parsing stops as soon as the boundary is found, the rest of the list has already been seen.
+   */
+  voter::scan_list(body, [&](const dpp::snowflake id, std::string& username, const std::string* avatar_hash) {
+    const auto index = ids.size();
+
+    ids.push_back(id);
+
+    if (seeded) {
+      voters.push_back(voter{id, std::move(username), avatar_hash ? std::optional<std::string_view>{*avatar_hash} : std::nullopt});
+    }
+
+    return head.empty() || !finder.feed(id, index);
+  });
+
+  const auto boundary = std::min(finder.match_start, ids.size());
+  std::vector<dpp::snowflake> new_head{ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(std::min(head_length, ids.size()))};
+
+  for (size_t i = 0; new_head.size() < head_length && i < head.size(); i++) {
+    if (std::find(new_head.begin(), new_head.end(), head[i]) == new_head.end()) {
+      new_head.push_back(head[i]);
+    }
+  }
+
+  head = std::move(new_head);
+
+  if (!seeded) {
+    for (const auto id: ids) {
+      remember(id, now);
+    }
+
+    seeded = true;
+
+    return delta{{}, ids.size()};
+  }
+
+  voters.erase(voters.begin() + static_cast<std::ptrdiff_t>(std::min(boundary, voters.size())), voters.end());
+
+  voters.erase(std::remove_if(voters.begin(), voters.end(), [this, now](const auto& v) {
+    return !remember(v.id, now);
+  }), voters.end());
+
+  return delta{std::move(voters), ids.size()};
+}
+
+/**
+ * Returns false if the voter has already been seen within the last 12 hours.
+ */
+bool vote_tracker::state::remember(const dpp::snowflake id, const time_t now) {
+  const auto existing = seen.find(id);
+
+  if (existing != seen.end()) {
+    if (now - existing->second < vote_cooldown) {
+      return false;
+    }
+
+    existing->second = now;
+  } else {
+    seen.insert(std::pair{id, now});
+  }
+
+  seen_order.push_back(std::pair{id, now});
+
+  while (seen.size() > max_seen && !seen_order.empty()) {
+    const auto oldest = seen_order.front();
+    seen_order.pop_front();
+
+    if (const auto entry = seen.find(oldest.first); entry != seen.end() && entry->second == oldest.second) {
+      seen.erase(entry);
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Entries are ordered by when they were remembered. An entry is only dropped if it wasn't remembered again since.
+ */
+void vote_tracker::state::expire(const time_t now) {
+  while (!seen_order.empty() && now - seen_order.front().second >= vote_cooldown) {
+    const auto oldest = seen_order.front();
+    seen_order.pop_front();
+
+    if (const auto entry = seen.find(oldest.first); entry != seen.end() && entry->second == oldest.second) {
+      seen.erase(entry);
+    }
+  }
+}
+
+vote_tracker::vote_tracker(client& topgg_client, const vote_tracker_callback_t& callback, const time_t interval, const size_t max_seen)
+  : m_context(topgg_client.m_context), m_timer(0), m_state(std::make_shared<state>()) {
+  if (interval < 15) {
+    throw std::invalid_argument{"Interval mustn't be shorter than 15 seconds."};
+  } else if (max_seen == 0) {
+    throw std::invalid_argument{"Maximum seen voters mustn't be zero."};
+  }
+
+  m_state->callback = callback;
+  m_state->max_seen = max_seen;
+  m_state->running = true;
+  m_state->polling = false;
+  m_state->seeded = false;
+
+  m_timer = m_context->cluster.start_timer([this](TOPGG_UNUSED dpp::timer) {
+    poll();
+  }, static_cast<uint64_t>(interval));
+
+  poll();
+}
+
+void vote_tracker::poll() {
+  {
+    std::lock_guard lock{m_state->mutex};
+
+    if (!m_state->running || m_state->polling) {
+      return;
+    }
+
+    m_state->polling = true;
+  }
+
+  /**
+   * Sent without coalescing, as the response is scanned against this tracker's own seen voters.
+   * Sharing it with another tracker's or a get_voters call's response would hand this tracker a result parsed for someone else.
+   */
+  client::dispatch(m_context, "/bots/votes", dpp::m_get, "", [tracker_state = m_state, max_body_size = m_context->max_body_size](const auto& response, const size_t attempts) {
+    const result<delta> polled_result{response, [tracker_state](const std::string& body) {
+      return tracker_state->scan(body);
+    }, attempts, max_body_size};
+
+    const delta* polled = nullptr;
+
+    try {
+      polled = &polled_result.get();
+    } catch (...) {}
+
+    vote_tracker_callback_t callback{};
+
+    {
+      std::lock_guard lock{tracker_state->mutex};
+
+      tracker_state->polling = false;
+
+      if (!tracker_state->running) {
+        return;
+      }
+
+      callback = tracker_state->callback;
+    }
+
+    if (polled != nullptr && !polled->voters.empty()) {
+      callback(polled->voters);
+    }
+  }, 1);
+}
+
+size_t vote_tracker::size() const {
+  std::lock_guard lock{m_state->mutex};
+
+  return m_state->seen.size();
+}
+
+void vote_tracker::stop() noexcept {
+  if (m_timer) {
+    m_context->cluster.stop_timer(m_timer);
+    m_timer = 0;
+  }
+
+  std::lock_guard lock{m_state->mutex};
+  m_state->running = false;
+}
+
+vote_tracker::~vote_tracker() {
+  stop();
+}
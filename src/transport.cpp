@@ -0,0 +1,7 @@
+#include <topgg/topgg.h>
+
+using topgg::dpp_transport;
+
+void dpp_transport::request(const std::string& url, const dpp::http_method method, const std::string& body, const std::multimap<std::string, std::string>& headers, dpp::http_completion_event&& callback) {
+  m_cluster.request(url, method, std::move(callback), body, "application/json", headers);
+}
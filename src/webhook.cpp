@@ -0,0 +1,544 @@
+#include <topgg/topgg.h>
+
+#ifdef __linux__
+
+#include <system_error>
+#include <string_view>
+#include <stdexcept>
+#include <charconv>
+#include <optional>
+#include <vector>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+
+#include <netinet/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using topgg::webhook_server;
+using topgg::vote_event;
+
+/**
+ * Top.gg's vote payloads are well under a kilobyte, anything much larger than that isn't a vote.
+ */
+static constexpr size_t max_header_size = 8192;
+static constexpr size_t max_body_size = 65536;
+static constexpr size_t max_connections = 1024;
+
+namespace {
+  /**
+   * A single HTTP/1.x request, with every view pointing into the connection's buffer.
+   */
+  struct request {
+    size_t length;
+    uint16_t error;
+    bool is_post;
+    bool keep_alive;
+    std::string_view authorization;
+    std::string_view body;
+  };
+} // namespace
+
+static bool iequals(const std::string_view a, const std::string_view b) noexcept {
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < a.size(); i++) {
+    auto c = a[i];
+
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+
+    if (c != b[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static std::string_view trim(std::string_view value) noexcept {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+
+  return value;
+}
+
+/**
+ * Parses the first request in the input in a single pass, without copying anything.
+ * A zero length without an error means that the request hasn't been fully received yet.
+ */
+static request parse_request(const std::string_view input) noexcept {
+  request r{0, 0, false, false, {}, {}};
+  const auto header_end = input.find("\r\n\r\n");
+
+  if (header_end == std::string_view::npos) {
+    if (input.size() > max_header_size) {
+      r.error = 431;
+    }
+
+    return r;
+  } else if (header_end > max_header_size) {
+    r.error = 431;
+
+    return r;
+  }
+
+  const auto headers = input.substr(0, header_end + 2);
+  auto line_end = headers.find("\r\n");
+  const auto request_line = headers.substr(0, line_end);
+  const auto method_end = request_line.find(' ');
+  const auto version_start = request_line.rfind(' ');
+
+  if (method_end == std::string_view::npos || version_start == method_end || request_line.substr(version_start + 1, 7) != "HTTP/1.") {
+    r.error = 400;
+
+    return r;
+  }
+
+  r.is_post = request_line.substr(0, method_end) == "POST";
+  r.keep_alive = request_line.substr(version_start + 1) != "HTTP/1.0";
+
+  size_t content_length = 0;
+  size_t line_start = line_end + 2;
+
+  while (line_start < headers.size()) {
+    line_end = headers.find("\r\n", line_start);
+
+    const auto line = headers.substr(line_start, line_end - line_start);
+    const auto colon = line.find(':');
+
+    line_start = line_end + 2;
+
+    if (colon == std::string_view::npos) {
+      r.error = 400;
+
+      return r;
+    }
+
+    const auto name = line.substr(0, colon);
+    const auto value = trim(line.substr(colon + 1));
+
+    if (iequals(name, "authorization")) {
+      r.authorization = value;
+    } else if (iequals(name, "content-length")) {
+      const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+
+      if (ec != std::errc{} || end != value.data() + value.size()) {
+        r.error = 400;
+
+        return r;
+      }
+    } else if (iequals(name, "transfer-encoding")) {
+      r.error = 411;
+
+      return r;
+    } else if (iequals(name, "connection")) {
+      if (iequals(value, "close")) {
+        r.keep_alive = false;
+      } else if (iequals(value, "keep-alive")) {
+        r.keep_alive = true;
+      }
+    }
+  }
+
+  if (content_length > max_body_size) {
+    r.error = 413;
+
+    return r;
+  }
+
+  const auto body_start = header_end + 4;
+
+  if (input.size() - body_start < content_length) {
+    return r;
+  }
+
+  r.body = input.substr(body_start, content_length);
+  r.length = body_start + content_length;
+
+  return r;
+}
+
+/**
+ * Compares the secret without returning early, so that response times don't reveal how much of it was guessed right.
+ */
+static bool secret_equals(const std::string_view given, const std::string& expected) noexcept {
+  if (given.size() != expected.size()) {
+    return false;
+  }
+
+  unsigned char difference = 0;
+
+  for (size_t i = 0; i < given.size(); i++) {
+    difference |= static_cast<unsigned char>(given[i] ^ expected[i]);
+  }
+
+  return difference == 0;
+}
+
+static const char* status_text(const uint16_t status) noexcept {
+  switch (status) {
+  case 204:
+    return "No Content";
+
+  case 400:
+    return "Bad Request";
+
+  case 401:
+    return "Unauthorized";
+
+  case 405:
+    return "Method Not Allowed";
+
+  case 411:
+    return "Length Required";
+
+  case 413:
+    return "Payload Too Large";
+
+  case 431:
+    return "Request Header Fields Too Large";
+
+  default:
+    return "Error";
+  }
+}
+
+static void respond(const int fd, const uint16_t status, const bool keep_alive) noexcept {
+  char response[128];
+  const auto length = std::snprintf(response, sizeof(response), "HTTP/1.1 %u %s\r\n%s%s\r\n", static_cast<unsigned>(status), status_text(status), status == 204 ? "" : "Content-Length: 0\r\n", keep_alive ? "" : "Connection: close\r\n");
+
+  /**
+   * The response always fits in an empty socket buffer. If it doesn't, the client stopped reading and the connection is closed anyway.
+   */
+  TOPGG_UNUSED const auto sent = ::send(fd, response, static_cast<size_t>(length), MSG_NOSIGNAL);
+}
+
+static void invoke(dpp::cluster& cluster, const topgg::vote_event_callback_t& callback, const vote_event& event) noexcept {
+  try {
+    callback(event);
+  } catch (const std::exception& ex) {
+    cluster.log(dpp::ll_error, std::string{"Uncaught exception in a Top.gg vote webhook callback: "} + ex.what());
+  } catch (...) {
+    cluster.log(dpp::ll_error, "Uncaught exception in a Top.gg vote webhook callback.");
+  }
+}
+
+webhook_server::webhook_server(dpp::cluster& cluster, client* topgg_client, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address, const time_t timeout)
+  : m_cluster(cluster), m_client(topgg_client), m_authorization(authorization), m_callback(callback), m_socket(-1), m_epoll(-1), m_wakeup(-1), m_port(port), m_timeout(timeout) {
+  if (authorization.empty()) {
+    throw std::invalid_argument{"Webhook authorization mustn't be empty."};
+  } else if (timeout <= 0) {
+    throw std::invalid_argument{"Webhook timeout must be positive."};
+  }
+
+  sockaddr_in local{};
+
+  local.sin_family = AF_INET;
+  local.sin_port = htons(port);
+
+  if (::inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1) {
+    throw std::invalid_argument{"Webhook address must be a valid IPv4 address."};
+  }
+
+  const auto fail = [this](const char* what) {
+    const auto error = errno;
+
+    close_sockets();
+
+    throw std::system_error{error, std::generic_category(), what};
+  };
+
+  m_socket = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  if (m_socket < 0) {
+    fail("Couldn't create the webhook socket");
+  }
+
+  const int reuse = 1;
+
+  ::setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  if (::bind(m_socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) < 0) {
+    fail("Couldn't bind the webhook socket");
+  } else if (::listen(m_socket, SOMAXCONN) < 0) {
+    fail("Couldn't listen on the webhook socket");
+  }
+
+  socklen_t local_size = sizeof(local);
+
+  if (::getsockname(m_socket, reinterpret_cast<sockaddr*>(&local), &local_size) == 0) {
+    m_port = ntohs(local.sin_port);
+  }
+
+  m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  m_wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  if (m_epoll < 0 || m_wakeup < 0) {
+    fail("Couldn't create the webhook event loop");
+  }
+
+  for (const auto fd: {m_socket, m_wakeup}) {
+    epoll_event event{};
+
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+      fail("Couldn't create the webhook event loop");
+    }
+  }
+
+  m_thread = std::thread{&webhook_server::run, this};
+}
+
+webhook_server::webhook_server(dpp::cluster& cluster, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address, const time_t timeout)
+  : webhook_server(cluster, nullptr, port, authorization, callback, address, timeout) {}
+
+webhook_server::webhook_server(client& topgg_client, const uint16_t port, const std::string& authorization, const vote_event_callback_t& callback, const std::string& address, const time_t timeout)
+  : webhook_server(topgg_client.m_cluster, &topgg_client, port, authorization, callback, address, timeout) {}
+
+/**
+ * While connections are open, epoll_wait wakes up at least once a second to close the ones whose deadline has passed.
+ */
+void webhook_server::run() {
+  epoll_event events[64];
+  auto next_sweep = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+
+  while (true) {
+    const auto count = ::epoll_wait(m_epoll, events, 64, m_connections.empty() ? -1 : 1000);
+
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      const auto fd = events[i].data.fd;
+
+      if (fd == m_wakeup) {
+        return;
+      } else if (fd == m_socket) {
+        accept_connections();
+      } else if (const auto connection = m_connections.find(fd); connection != m_connections.end() && !receive(fd, connection->second)) {
+        close_connection(fd);
+      }
+    }
+
+    if (const auto now = std::chrono::steady_clock::now(); now >= next_sweep) {
+      close_stale_connections();
+      next_sweep = now + std::chrono::seconds{1};
+    }
+  }
+}
+
+void webhook_server::accept_connections() {
+  while (true) {
+    const auto fd = ::accept4(m_socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return;
+    } else if (m_connections.size() >= max_connections) {
+      ::close(fd);
+      continue;
+    }
+
+    const int no_delay = 1;
+
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+    epoll_event event{};
+
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+      ::close(fd);
+      continue;
+    }
+
+    m_connections.insert(std::pair{fd, connection{std::string{}, std::chrono::steady_clock::now() + m_timeout}});
+  }
+}
+
+/**
+ * Reads everything available on the connection and answers every complete request in it.
+ * Returns false if the connection should be closed.
+ */
+bool webhook_server::receive(const int fd, connection& conn) {
+  auto& buffer = conn.buffer;
+  char chunk[16384];
+  bool open = true;
+
+  while (true) {
+    const auto received = ::recv(fd, chunk, sizeof(chunk), 0);
+
+    if (received > 0) {
+      buffer.append(chunk, static_cast<size_t>(received));
+
+      if (buffer.size() <= max_header_size + max_body_size) {
+        continue;
+      }
+    } else if (received == 0) {
+      open = false;
+    } else if (errno == EINTR) {
+      continue;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      return false;
+    }
+
+    break;
+  }
+
+  size_t consumed = 0;
+
+  while (consumed < buffer.size()) {
+    const auto r = parse_request(std::string_view{buffer}.substr(consumed));
+
+    if (r.error != 0) {
+      respond(fd, r.error, false);
+
+      return false;
+    } else if (r.length == 0) {
+      break;
+    }
+
+    consumed += r.length;
+
+    std::optional<vote_event> event{};
+    uint16_t status = 204;
+
+    if (!r.is_post) {
+      status = 405;
+    } else if (!secret_equals(r.authorization, m_authorization)) {
+      status = 401;
+    } else {
+      try {
+        event.emplace(vote_event{dpp::json::parse(r.body)});
+      } catch (...) {
+        status = 400;
+      }
+    }
+
+    respond(fd, status, open && r.keep_alive);
+
+    if (event.has_value()) {
+      dispatch(std::move(*event));
+    }
+
+    if (!r.keep_alive) {
+      return false;
+    }
+  }
+
+  buffer.erase(0, consumed);
+
+  if (consumed != 0) {
+    conn.deadline = std::chrono::steady_clock::now() + m_timeout;
+  }
+
+  if (buffer.size() > max_header_size + max_body_size) {
+    respond(fd, 413, false);
+
+    return false;
+  }
+
+  return open;
+}
+
+/**
+ * D++ 10.1 and above can run work on the cluster's own thread pool. Older versions don't expose it, so the callback is called on the webhook thread instead,
+ * after the response has already been sent.
+ */
+void webhook_server::dispatch(vote_event&& event) {
+  if (m_client != nullptr && !event.is_test) {
+    m_client->cache_vote(event.voter_id);
+  }
+
+#if defined(DPP_VERSION_LONG) && DPP_VERSION_LONG >= 0x00100100
+  m_cluster.queue_work(0, [&cluster = m_cluster, callback = m_callback, event = std::move(event)]() {
+    invoke(cluster, callback, event);
+  });
+#else
+  invoke(m_cluster, m_callback, event);
+#endif
+}
+
+void webhook_server::close_connection(const int fd) noexcept {
+  ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+
+  m_connections.erase(fd);
+}
+
+void webhook_server::close_stale_connections() noexcept {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<int> stale{};
+
+  for (const auto& connection: m_connections) {
+    if (connection.second.deadline <= now) {
+      stale.push_back(connection.first);
+    }
+  }
+
+  for (const auto fd: stale) {
+    close_connection(fd);
+  }
+}
+
+void webhook_server::close_sockets() noexcept {
+  for (const auto& connection: m_connections) {
+    ::close(connection.first);
+  }
+
+  m_connections.clear();
+
+  for (auto fd: {&m_socket, &m_epoll, &m_wakeup}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+uint16_t webhook_server::port() const noexcept {
+  return m_port;
+}
+
+void webhook_server::stop() noexcept {
+  if (m_thread.joinable()) {
+    const uint64_t wakeup = 1;
+
+    TOPGG_UNUSED const auto written = ::write(m_wakeup, &wakeup, sizeof(wakeup));
+
+    m_thread.join();
+  }
+
+  close_sockets();
+}
+
+webhook_server::~webhook_server() {
+  stop();
+}
+
+#endif
@@ -0,0 +1,226 @@
+#include "test.h"
+
+#include <stdexcept>
+#include <optional>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <memory>
+#include <ctime>
+#include <map>
+
+/**
+ * Checks the hand-written ISO 8601 parser behind topgg::bot::approved_at against known unix timestamps,
+ * and that malformed dates are rejected instead of being read as something else.
+ *
+ * Also checks that the direct JSON writer behind post_stats produces exactly what dpp::json::dump() does for the same fields, with every optional field present or absent.
+ */
+
+/**
+ * Answers every request with the same 200 OK body before returning from request(), and records the last request's body.
+ */
+class canned_transport: public topgg::transport {
+public:
+  std::string body;
+  std::string last_request_body;
+
+  void request(TOPGG_UNUSED const std::string& url, TOPGG_UNUSED const dpp::http_method method, const std::string& request_body, TOPGG_UNUSED const std::multimap<std::string, std::string>& headers, dpp::http_completion_event&& callback) override {
+    dpp::http_request_completion_t response{};
+
+    last_request_body = request_body;
+
+    response.status = 200;
+    response.body = body;
+
+    callback(response);
+  }
+};
+
+/**
+ * Models are only constructed from JSON and serialized by the client, so they're tested through one.
+ */
+class canned_client {
+  std::shared_ptr<canned_transport> m_transport;
+  topgg::client m_client;
+
+public:
+  inline canned_client(dpp::cluster& cluster)
+    : m_transport(std::make_shared<canned_transport>()), m_client(cluster, "test token") {
+    m_client.set_transport(m_transport);
+  }
+
+  /**
+   * Fetches a bot whose date field is the given string. Returns std::nullopt if the bot is rejected for having an invalid date.
+   */
+  std::optional<time_t> approved_at(const std::string& date) {
+    std::optional<time_t> approved_at{};
+
+    m_transport->body = dpp::json{
+      {"certifiedBot", false},
+      {"date", date},
+      {"discriminator", "0"},
+      {"id", "264811613708746752"},
+      {"monthlyPoints", 0},
+      {"points", 0},
+      {"prefix", "!"},
+      {"shortdesc", "A bot."},
+      {"username", "Bot"},
+    }.dump();
+
+    m_client.get_bot(264811613708746752, [&approved_at](const auto& result) {
+      try {
+        approved_at = result.get().approved_at;
+      } catch (TOPGG_UNUSED const std::invalid_argument&) {}
+    });
+
+    return approved_at;
+  }
+
+  /**
+   * Fetches stats from the given JSON body.
+   */
+  topgg::stats fetched_stats(const std::string& body) {
+    std::optional<topgg::stats> fetched{};
+
+    m_transport->body = body;
+
+    m_client.get_stats([&fetched](const auto& result) {
+      fetched.emplace(result.get());
+    });
+
+    return fetched.value();
+  }
+
+  /**
+   * Returns the request body post_stats sends for the given stats.
+   */
+  std::string posted_stats(const topgg::stats& s) {
+    m_transport->body = "{}";
+
+    m_client.post_stats(s, [](TOPGG_UNUSED const bool success) {});
+
+    return m_transport->last_request_body;
+  }
+};
+
+int main() {
+  dpp::cluster cluster{"test token"};
+  canned_client client{cluster};
+
+  const auto parses_to = [&client](const std::string& date, const time_t expected) {
+    return client.approved_at(date) == std::optional{expected};
+  };
+
+  const auto rejects = [&client](const std::string& date) {
+    return !client.approved_at(date).has_value();
+  };
+
+  /**
+   * Stats read from a body holding only stats fields are posted with exactly those fields, so dumping the parsed body is the expected output.
+   */
+  const auto round_trips = [&client](const std::string& body) {
+    return client.posted_stats(client.fetched_stats(body)) == dpp::json::parse(body).dump();
+  };
+
+  CHECK(parses_to("1970-01-01T00:00:00Z", 0));
+  CHECK(parses_to("2017-04-26T18:08:17Z", 1493230097));
+  CHECK(parses_to("2017-04-26t18:08:17z", 1493230097));
+  CHECK(parses_to("2017-04-26 18:08:17Z", 1493230097));
+  CHECK(parses_to("2017-04-26T18:08:17", 1493230097));
+  CHECK(parses_to("1999-12-31T23:59:59Z", 946684799));
+
+  CHECK(parses_to("2017-04-26T20:08:17+02:00", 1493230097));
+  CHECK(parses_to("2017-04-26T13:08:17-05:00", 1493230097));
+  CHECK(parses_to("2017-04-26T23:38:17+0530", 1493230097));
+  CHECK(parses_to("2017-04-26T18:08:17+00:00", 1493230097));
+  CHECK(parses_to("2017-04-27T01:08:17+07:00", 1493230097));
+  CHECK(parses_to("2017-04-25T23:08:17-19:00", 1493230097));
+
+  CHECK(parses_to("2017-04-26T18:08:17.125Z", 1493230097));
+  CHECK(parses_to("2017-04-26T18:08:17.999999999Z", 1493230097));
+  CHECK(parses_to("2017-04-26T18:08:17,5Z", 1493230097));
+  CHECK(parses_to("2017-04-26T20:08:17.125+02:00", 1493230097));
+
+  CHECK(parses_to("2000-02-29T12:00:00Z", 951825600));
+  CHECK(parses_to("2020-02-29T00:00:00Z", 1582934400));
+  CHECK(parses_to("2024-02-29T23:59:59Z", 1709251199));
+  CHECK(parses_to("2024-03-01T00:59:59+01:00", 1709251199));
+
+  CHECK(rejects("2019-02-29T00:00:00Z"));
+  CHECK(rejects("1900-02-29T00:00:00Z"));
+  CHECK(rejects("2017-04-31T00:00:00Z"));
+  CHECK(rejects("2017-13-01T00:00:00Z"));
+  CHECK(rejects("2017-00-01T00:00:00Z"));
+  CHECK(rejects("2017-04-00T00:00:00Z"));
+  CHECK(rejects("2017-04-26T24:00:00Z"));
+  CHECK(rejects("2017-04-26T18:60:00Z"));
+
+  CHECK(rejects(""));
+  CHECK(rejects("2017-04-26"));
+  CHECK(rejects("2017-04-26T18:08"));
+  CHECK(rejects("2017/04/26T18:08:17Z"));
+  CHECK(rejects("17-04-26T18:08:17Z"));
+  CHECK(rejects("abcd-04-26T18:08:17Z"));
+  CHECK(rejects("2017-04-26X18:08:17Z"));
+  CHECK(rejects("2017-04-26T18:08:17."));
+  CHECK(rejects("2017-04-26T18:08:17.Z"));
+  CHECK(rejects("2017-04-26T18:08:17Zjunk"));
+  CHECK(rejects("2017-04-26T18:08:17 "));
+  CHECK(rejects("2017-04-26T18:08:17+2:00"));
+  CHECK(rejects("2017-04-26T18:08:17+02:0"));
+  CHECK(rejects("2017-04-26T18:08:17+24:00"));
+  CHECK(rejects("2017-04-26T18:08:17+02:60"));
+  CHECK(rejects("2017-04-26T18:08:17+"));
+
+  CHECK(round_trips("{}"));
+  CHECK(round_trips("{\"server_count\":0}"));
+  CHECK(round_trips("{\"server_count\":1234}"));
+  CHECK(round_trips("{\"shard_count\":16}"));
+  CHECK(round_trips("{\"shard_id\":3}"));
+  CHECK(round_trips("{\"shards\":[]}"));
+  CHECK(round_trips("{\"shards\":[5]}"));
+  CHECK(round_trips("{\"shards\":[1,20,300,4000]}"));
+  CHECK(round_trips("{\"server_count\":1234,\"shard_count\":16}"));
+  CHECK(round_trips("{\"shard_count\":4,\"shard_id\":2}"));
+  CHECK(round_trips("{\"server_count\":4321,\"shards\":[1,20,300,4000]}"));
+  CHECK(round_trips("{\"server_count\":4321,\"shard_count\":4,\"shard_id\":0,\"shards\":[1,20,300,4000]}"));
+  CHECK(round_trips("{\"server_count\":18446744073709551615,\"shard_count\":18446744073709551615,\"shard_id\":18446744073709551615,\"shards\":[0,18446744073709551615]}"));
+
+  /**
+   * Stats built by the public constructors.
+   */
+  const auto posts = [&client](const topgg::stats& s, const dpp::json& expected) {
+    return client.posted_stats(s) == expected.dump();
+  };
+
+  CHECK(posts(topgg::stats{1234, 16}, dpp::json{{"server_count", 1234}, {"shard_count", 16}}));
+  CHECK(posts(topgg::stats{0}, dpp::json{{"server_count", 0}, {"shard_count", 1}}));
+  CHECK(posts(topgg::stats{std::vector<size_t>{3, 4}, 1}, dpp::json{{"server_count", 7}, {"shard_count", 2}, {"shard_id", 1}, {"shards", {3, 4}}}));
+
+  {
+    std::vector<size_t> shards(1000);
+
+    for (size_t i = 0; i < shards.size(); i++) {
+      shards[i] = i * 7919;
+    }
+
+    const dpp::json expected{
+      {"server_count", std::accumulate(shards.begin(), shards.end(), size_t{0})},
+      {"shard_count", shards.size()},
+      {"shard_id", 999},
+      {"shards", shards},
+    };
+
+    CHECK(posts(topgg::stats{shards, 999}, expected));
+  }
+
+  {
+    auto s = client.fetched_stats("{\"shard_id\":3}");
+
+    s.set_server_count(99);
+
+    CHECK(posts(s, dpp::json{{"server_count", 99}, {"shard_id", 3}}));
+  }
+
+  return finish("models");
+}
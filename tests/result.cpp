@@ -0,0 +1,100 @@
+#include "test.h"
+
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+/**
+ * Checks that topgg::internal_result::decode inflates gzip-compressed bodies, passes plain ones through untouched,
+ * and enforces the maximum body size on both the compressed and the inflated size, so a small zip bomb can't inflate without bound.
+ */
+
+static std::string gzip(const std::string& input) {
+  z_stream stream{};
+
+  if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error{"deflateInit2"};
+  }
+
+  std::string output(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream.avail_in = static_cast<uInt>(input.size());
+  stream.next_out = reinterpret_cast<Bytef*>(output.data());
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  const auto status = deflate(&stream, Z_FINISH);
+
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  if (status != Z_STREAM_END) {
+    throw std::runtime_error{"deflate"};
+  }
+
+  return output;
+}
+
+/**
+ * Returns the decoded body, or the name of the exception decode threw.
+ */
+static std::string decode(const std::string& body, const size_t max_size) {
+  try {
+    return topgg::internal_result::decode(body, max_size);
+  } catch (const topgg::response_too_large& ex) {
+    return ex.max_size == max_size ? "response_too_large" : "response_too_large with the wrong max_size";
+  } catch (TOPGG_UNUSED const topgg::internal_server_error&) {
+    return "internal_server_error";
+  }
+}
+
+int main() {
+  const std::string json{"{\"server_count\":2,\"shards\":[1,1],\"shard_count\":2,\"voters\":[\"" + std::string(100000, 'a') + "\"]}"};
+  const auto compressed = gzip(json);
+
+  CHECK(compressed.size() < json.size() / 10);
+  CHECK(decode(compressed, 1024 * 1024) == json);
+
+  /**
+   * The thread's inflate buffer is reused, so a smaller body decoded after a larger one mustn't keep the larger one's tail.
+   */
+  CHECK(decode(gzip("{}"), 1024 * 1024) == "{}");
+  CHECK(decode(gzip(""), 1024 * 1024) == "");
+
+  {
+    const std::string plain{"{\"voted\":1}"};
+    const auto& decoded = topgg::internal_result::decode(plain, 1024);
+
+    CHECK(&decoded == &plain);
+    CHECK(decode(plain, plain.size()) == plain);
+    CHECK(decode(plain, plain.size() - 1) == "response_too_large");
+    CHECK(decode("", 1) == "");
+  }
+
+  CHECK(decode(compressed, compressed.size() - 1) == "response_too_large");
+  CHECK(decode(compressed, json.size()) == json);
+  CHECK(decode(compressed, json.size() - 1) == "response_too_large");
+
+  {
+    const auto bomb = gzip(std::string(64 * 1024 * 1024, '\0'));
+
+    CHECK(bomb.size() < 128 * 1024);
+    CHECK(decode(bomb, 1024 * 1024) == "response_too_large");
+  }
+
+  CHECK(decode(compressed.substr(0, compressed.size() - 8), 1024 * 1024) == "internal_server_error");
+  CHECK(decode(compressed.substr(0, compressed.size() / 2), 1024 * 1024) == "internal_server_error");
+  CHECK(decode(compressed.substr(0, 10), 1024 * 1024) == "internal_server_error");
+  CHECK(decode(compressed.substr(0, 2), 1024 * 1024) == "internal_server_error");
+
+  {
+    auto corrupted = compressed;
+
+    corrupted[corrupted.size() / 2] = static_cast<char>(corrupted[corrupted.size() / 2] ^ 0xff);
+
+    CHECK(decode(corrupted, 1024 * 1024) == "internal_server_error");
+  }
+
+  return finish("result");
+}
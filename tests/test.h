@@ -0,0 +1,42 @@
+/**
+ * @module topgg
+ * @file test.h
+ * @brief A tiny test harness for the Top.gg C++ SDK.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <topgg/topgg.h>
+
+#include <cstdio>
+
+/**
+ * Every file in this directory is its own test executable. A failed check doesn't stop the test, it's printed and counted,
+ * and finish() turns the count into the exit code ctest reads.
+ */
+
+static int failures = 0;
+
+#define CHECK(condition)                                                        \
+  do {                                                                          \
+    if (!(condition)) {                                                         \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                               \
+    }                                                                           \
+  } while (false)
+
+static int finish(const char* name) {
+  if (failures != 0) {
+    std::fprintf(stderr, "%d check(s) failed.\n", failures);
+
+    return 1;
+  }
+
+  std::printf("All %s checks passed.\n", name);
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+#include "test.h"
+
+#include <condition_variable>
+#include <system_error>
+#include <string_view>
+#include <stdexcept>
+#include <optional>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <cerrno>
+#include <mutex>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+/**
+ * Sends raw HTTP requests to a topgg::webhook_server on the loopback interface and checks every response's status line,
+ * that only a well-formed, authorized vote reaches the callback, and that connections which never complete a request are closed.
+ */
+
+static constexpr const char* secret = "test secret";
+
+static int open_connection(const uint16_t port, const timeval timeout) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), "socket"};
+  }
+
+  sockaddr_in remote{};
+
+  remote.sin_family = AF_INET;
+  remote.sin_port = htons(port);
+  remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  if (::connect(fd, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote)) < 0) {
+    const auto error = errno;
+
+    ::close(fd);
+
+    throw std::system_error{error, std::generic_category(), "connect"};
+  }
+
+  return fd;
+}
+
+/**
+ * Opens a new connection, sends the request, and returns everything received until the server closes the connection
+ * or the end of a response without a body.
+ */
+static std::string round_trip(const uint16_t port, const std::string& request) {
+  const auto fd = open_connection(port, timeval{5, 0});
+
+  ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+  std::string response{};
+  char buffer[1024];
+
+  while (response.find("\r\n\r\n") == std::string::npos) {
+    const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+
+    if (received <= 0) {
+      break;
+    }
+
+    response.append(buffer, static_cast<size_t>(received));
+  }
+
+  ::close(fd);
+
+  return response;
+}
+
+/**
+ * Opens a new connection and trickles the partial request in one byte every 250 milliseconds, or sends nothing if it's empty.
+ * Returns true if the server closes the connection within 5 seconds without answering.
+ */
+static bool is_closed_while_idle(const uint16_t port, const std::string& partial_request) {
+  const auto fd = open_connection(port, timeval{0, 250000});
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  size_t sent = 0;
+  bool closed = false;
+
+  while (!closed && std::chrono::steady_clock::now() < deadline) {
+    if (sent < partial_request.size() && ::send(fd, partial_request.data() + sent++, 1, MSG_NOSIGNAL) < 0) {
+      closed = true;
+      break;
+    }
+
+    char buffer[1024];
+    const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+
+    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      closed = true;
+    } else if (received > 0) {
+      break;
+    }
+  }
+
+  ::close(fd);
+
+  return closed;
+}
+
+static std::string post(const std::string& body, const std::string& authorization = secret) {
+  return "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: " + authorization + "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+}
+
+static bool has_status(const std::string& response, const std::string_view status_line) {
+  return std::string_view{response}.substr(0, status_line.size()) == status_line;
+}
+
+int main() {
+  dpp::cluster cluster{"test token"};
+
+  std::mutex mutex{};
+  std::condition_variable received{};
+  std::optional<topgg::vote_event> vote{};
+  size_t votes = 0;
+
+  topgg::webhook_server server{cluster, 0, secret, [&](const topgg::vote_event& event) {
+    std::lock_guard lock{mutex};
+
+    vote.emplace(event);
+    votes++;
+    received.notify_all();
+  }, "127.0.0.1"};
+
+  const auto port = server.port();
+
+  CHECK(has_status(round_trip(port, post("{\"bot\":\"264811613708746752\",\"user\":\"661200758510977084\",\"type\":\"upvote\",\"isWeekend\":true,\"query\":\"?ref=test&a=1\"}")), "HTTP/1.1 204 No Content\r\n"));
+
+  {
+    std::unique_lock lock{mutex};
+
+    CHECK(received.wait_for(lock, std::chrono::seconds{5}, [&votes]() { return votes != 0; }));
+
+    if (vote.has_value()) {
+      CHECK(vote->receiver_id == dpp::snowflake{264811613708746752});
+      CHECK(vote->voter_id == dpp::snowflake{661200758510977084});
+      CHECK(!vote->is_test);
+      CHECK(vote->is_weekend);
+      CHECK(vote->query.size() == 2);
+    }
+  }
+
+  CHECK(has_status(round_trip(port, post("{\"bot\":\"264811613708746752\",\"user\":\"661200758510977084\",\"type\":\"upvote\"}", "wrong secret")), "HTTP/1.1 401 Unauthorized\r\n"));
+  CHECK(has_status(round_trip(port, "GET /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: test secret\r\nConnection: close\r\n\r\n"), "HTTP/1.1 405 Method Not Allowed\r\n"));
+
+  CHECK(has_status(round_trip(port, post("{}")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("[]")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("not json")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("{\"bot\":\"264811613708746752\",\"type\":\"upvote\"}")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("{\"bot\":\"264811613708746752\",\"user\":661200758510977084,\"type\":\"upvote\"}")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("{\"user\":\"661200758510977084\",\"type\":\"upvote\"}")), "HTTP/1.1 400 Bad Request\r\n"));
+  CHECK(has_status(round_trip(port, post("{\"bot\":\"264811613708746752\",\"user\":\"661200758510977084\"}")), "HTTP/1.1 400 Bad Request\r\n"));
+
+  CHECK(has_status(round_trip(port, "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: test secret\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n"), "HTTP/1.1 411 Length Required\r\n"));
+  CHECK(has_status(round_trip(port, "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: test secret\r\nContent-Length: 1000000\r\n\r\n"), "HTTP/1.1 413 Payload Too Large\r\n"));
+  CHECK(has_status(round_trip(port, "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nX-Padding: " + std::string(16384, 'a') + "\r\n\r\n"), "HTTP/1.1 431 Request Header Fields Too Large\r\n"));
+
+  {
+    std::lock_guard lock{mutex};
+
+    CHECK(votes == 1);
+  }
+
+  server.stop();
+
+  topgg::webhook_server impatient_server{cluster, 0, secret, [](TOPGG_UNUSED const topgg::vote_event& event) {}, "127.0.0.1", 1};
+
+  CHECK(is_closed_while_idle(impatient_server.port(), ""));
+  CHECK(is_closed_while_idle(impatient_server.port(), "POST /votes HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: test secret\r\nX-Padding: " + std::string(64, 'a')));
+
+  impatient_server.stop();
+
+  return finish("webhook");
+}
@@ -0,0 +1,62 @@
+#include "mock_server.h"
+
+#include <iostream>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+static volatile std::sig_atomic_t running = 1;
+
+static void usage(const char* program) {
+  std::cerr << "usage: " << program << " [--port N] [--latency-ms N] [--ratelimit-every N] [--retry-after N] [--voters N] [--gzip 0|1]" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  topgg::mock::options opts{};
+  opts.port = 8080;
+
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+
+    const auto value = std::strtoull(argv[i + 1], nullptr, 10);
+
+    if (std::strcmp(argv[i], "--port") == 0) {
+      opts.port = static_cast<uint16_t>(value);
+    } else if (std::strcmp(argv[i], "--latency-ms") == 0) {
+      opts.latency = std::chrono::milliseconds{value};
+    } else if (std::strcmp(argv[i], "--ratelimit-every") == 0) {
+      opts.ratelimit_every = static_cast<size_t>(value);
+    } else if (std::strcmp(argv[i], "--retry-after") == 0) {
+      opts.retry_after = static_cast<uint16_t>(value);
+    } else if (std::strcmp(argv[i], "--voters") == 0) {
+      opts.voters = static_cast<size_t>(value);
+    } else if (std::strcmp(argv[i], "--gzip") == 0) {
+      opts.gzip = value != 0;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+
+    i++;
+  }
+
+  std::signal(SIGINT, [](int) { running = 0; });
+  std::signal(SIGTERM, [](int) { running = 0; });
+
+  topgg::mock::server mock{opts};
+
+  std::cout << "mock Top.gg API listening on http://127.0.0.1:" << mock.port() << "/api" << std::endl;
+
+  while (running) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+  }
+
+  mock.stop();
+
+  std::cout << "served " << mock.requests() << " requests" << std::endl;
+
+  return 0;
+}
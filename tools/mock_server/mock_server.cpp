@@ -0,0 +1,357 @@
+#include "mock_server.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+
+using topgg::mock::server;
+
+std::string topgg::mock::bot_json(const uint64_t id) {
+  const auto id_str = std::to_string(id);
+
+  return "{\"id\":\"" + id_str + "\",\"username\":\"Mock Bot\",\"avatar\":\"a_1ab2c3d4e5f6a7b8c9d0e1f2a3b4c5d6\",\"discriminator\":\"0\",\"prefix\":\"!\","
+         "\"shortdesc\":\"A mock bot served by topgg_mock_server.\",\"longdesc\":\"" + std::string(2048, 'x') + "\","
+         "\"tags\":[\"fun\",\"moderation\",\"utility\"],\"website\":\"https://example.com\",\"github\":\"\",\"owners\":[\"661200758510977084\"],"
+         "\"guilds\":[],\"bannerUrl\":\"\",\"date\":\"2017-04-26T18:08:17.125Z\",\"certifiedBot\":true,\"shards\":[],\"points\":1234567,"
+         "\"monthlyPoints\":12345,\"support\":\"dbl\",\"shard_count\":16,\"vanity\":\"mock\",\"invite\":\"\"}";
+}
+
+std::string topgg::mock::user_json(const uint64_t id) {
+  return "{\"id\":\"" + std::to_string(id) + "\",\"username\":\"mock user\",\"avatar\":\"1ab2c3d4e5f6a7b8c9d0e1f2a3b4c5d6\",\"bio\":\"Hello!\",\"banner\":\"\","
+         "\"socials\":{\"github\":\"https://github.com/top-gg-community\",\"youtube\":\"\"},\"supporter\":false,\"certifiedDev\":true,\"mod\":false,\"webMod\":false,\"admin\":false}";
+}
+
+std::string topgg::mock::sparse_user_json(const uint64_t id) {
+  return "{\"id\":\"" + std::to_string(id) + "\",\"username\":\"mock user\",\"avatar\":null,\"bio\":null,\"banner\":null,"
+         "\"socials\":{},\"supporter\":false,\"certifiedDev\":false,\"mod\":false,\"webMod\":false,\"admin\":false}";
+}
+
+std::string topgg::mock::voters_json(const size_t count) {
+  std::string body{"["};
+
+  body.reserve(count * 96 + 2);
+
+  for (size_t i = 0; i < count; i++) {
+    if (i != 0) {
+      body.push_back(',');
+    }
+
+    body.append("{\"username\":\"voter");
+    body.append(std::to_string(i));
+    body.append("\",\"id\":\"");
+    body.append(std::to_string(661200758510977084ULL + i));
+    body.append(i % 4 == 0 ? "\",\"avatar\":null}" : "\",\"avatar\":\"1ab2c3d4e5f6a7b8c9d0e1f2a3b4c5d6\"}");
+  }
+
+  body.push_back(']');
+
+  return body;
+}
+
+std::string topgg::mock::stats_json(const size_t shards) {
+  std::string body{"{\"server_count\":"};
+
+  body.append(std::to_string(shards * 1000));
+  body.append(",\"shard_count\":");
+  body.append(std::to_string(shards));
+  body.append(",\"shards\":[");
+
+  for (size_t i = 0; i < shards; i++) {
+    if (i != 0) {
+      body.push_back(',');
+    }
+
+    body.append("1000");
+  }
+
+  body.append("]}");
+
+  return body;
+}
+
+std::string topgg::mock::gzip(const std::string& body) {
+  z_stream stream{};
+
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error{"Unable to initialize gzip compression."};
+  }
+
+  std::string compressed(deflateBound(&stream, static_cast<uLong>(body.size())), '\0');
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+  stream.avail_in = static_cast<uInt>(body.size());
+  stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+  stream.avail_out = static_cast<uInt>(compressed.size());
+
+  const auto status = deflate(&stream, Z_FINISH);
+
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  if (status != Z_STREAM_END) {
+    throw std::runtime_error{"Unable to compress with gzip."};
+  }
+
+  return compressed;
+}
+
+static std::string http_response(const int status, const char* reason, const std::string& body, const std::string& extra_headers = "") {
+  return "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n" + extra_headers + "\r\n" + body;
+}
+
+static uint64_t id_of(const std::string& path, const size_t prefix_length) {
+  try {
+    return std::stoull(path.substr(prefix_length));
+  } catch (const std::exception&) {
+    return 0;
+  }
+}
+
+server::server(const options& opts)
+  : m_options(opts), m_voters(voters_json(opts.voters)), m_voters_gzip(opts.gzip ? gzip(m_voters) : ""), m_socket(-1), m_port(0), m_running(true), m_requests(0) {
+  m_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  if (m_socket < 0) {
+    throw std::runtime_error{"Unable to create a socket."};
+  }
+
+  const int enable = 1;
+  setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(opts.port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (::bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_socket, 128) != 0) {
+    ::close(m_socket);
+    throw std::runtime_error{"Unable to listen on the given port."};
+  }
+
+  socklen_t address_length = sizeof(address);
+  getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &address_length);
+  m_port = ntohs(address.sin_port);
+
+  m_acceptor = std::thread{&server::accept_loop, this};
+}
+
+void server::accept_loop() {
+  auto backoff = std::chrono::milliseconds{10};
+
+  while (m_running) {
+    const auto connection = ::accept(m_socket, nullptr, nullptr);
+
+    if (connection < 0) {
+      if (!m_running) {
+        break;
+      } else if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+
+      /**
+       * Running out of file descriptors (EMFILE, ENFILE) or memory leaves the connection queued, so accepting again right away would spin.
+       * Wait until another connection is closed, the server is stopped, or the backoff runs out.
+       */
+      std::unique_lock lock{m_mutex};
+      const auto open = m_connections.size();
+
+      m_idle.wait_for(lock, backoff, [this, open]() {
+        return !m_running || m_connections.size() < open;
+      });
+
+      backoff = std::min(backoff * 2, std::chrono::milliseconds{1000});
+      continue;
+    }
+
+    backoff = std::chrono::milliseconds{10};
+
+    const int enable = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    std::lock_guard lock{m_mutex};
+
+    if (!m_running) {
+      ::close(connection);
+      break;
+    }
+
+    m_connections.push_back(connection);
+    std::thread{&server::serve, this, connection}.detach();
+  }
+}
+
+void server::serve(const int connection) {
+  handle(connection);
+
+  std::lock_guard lock{m_mutex};
+
+  m_connections.erase(std::find(m_connections.begin(), m_connections.end(), connection));
+  ::close(connection);
+
+  m_idle.notify_all();
+}
+
+std::string server::respond(const std::string& method, const std::string& target, const bool authorized, const bool accepts_gzip) {
+  const auto request_number = ++m_requests;
+  const auto compress = m_options.gzip && accepts_gzip;
+
+  const auto ok = [compress](const std::string& body) {
+    return compress ? http_response(200, "OK", gzip(body), "Content-Encoding: gzip\r\n") : http_response(200, "OK", body);
+  };
+
+  if (m_options.latency.count() > 0) {
+    std::this_thread::sleep_for(m_options.latency);
+  }
+
+  if (!authorized) {
+    return http_response(401, "Unauthorized", "{\"error\":\"Unauthorized\"}");
+  }
+
+  if (m_options.ratelimit_every != 0 && request_number % m_options.ratelimit_every == 0) {
+    const auto retry_after = std::to_string(m_options.retry_after);
+
+    return http_response(429, "Too Many Requests", "{\"retry_after\":" + retry_after + "}", "Retry-After: " + retry_after + "\r\n");
+  }
+
+  if (method == "POST") {
+    return target == "/api/bots/stats" ? ok("{}") : http_response(404, "Not Found", "{\"error\":\"Not Found\"}");
+  }
+
+  if (target.rfind("/api/bots/votes?userId=", 0) == 0) {
+    return ok("{\"voted\":1}");
+  } else if (target == "/api/bots/votes") {
+    return compress ? http_response(200, "OK", m_voters_gzip, "Content-Encoding: gzip\r\n") : http_response(200, "OK", m_voters);
+  } else if (target == "/api/bots/stats") {
+    return ok(stats_json(16));
+  } else if (target == "/api/weekend") {
+    return ok("{\"is_weekend\":false}");
+  } else if (target.rfind("/api/bots/", 0) == 0) {
+    return ok(bot_json(id_of(target, 10)));
+  } else if (target.rfind("/api/users/", 0) == 0) {
+    return ok(user_json(id_of(target, 11)));
+  }
+
+  return http_response(404, "Not Found", "{\"error\":\"Not Found\"}");
+}
+
+void server::handle(const int connection) {
+  std::string buffer{};
+  char chunk[16384];
+
+  while (m_running) {
+    auto header_end = buffer.find("\r\n\r\n");
+
+    while (header_end == std::string::npos) {
+      const auto received = ::recv(connection, chunk, sizeof(chunk), 0);
+
+      if (received <= 0) {
+        return;
+      }
+
+      buffer.append(chunk, static_cast<size_t>(received));
+      header_end = buffer.find("\r\n\r\n");
+    }
+
+    auto head = buffer.substr(0, header_end);
+    std::transform(head.begin(), head.end(), head.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    const auto request_line_end = buffer.find("\r\n");
+    const auto method_end = buffer.find(' ');
+    const auto target_end = buffer.find(' ', method_end + 1);
+
+    if (method_end == std::string::npos || target_end == std::string::npos || target_end > request_line_end) {
+      return;
+    }
+
+    const auto method = buffer.substr(0, method_end);
+    const auto target = buffer.substr(method_end + 1, target_end - method_end - 1);
+
+    size_t content_length = 0;
+
+    if (const auto content_length_pos = head.find("\r\ncontent-length:"); content_length_pos != std::string::npos) {
+      content_length = std::strtoull(head.c_str() + content_length_pos + 17, nullptr, 10);
+    }
+
+    const auto request_end = header_end + 4 + content_length;
+
+    while (buffer.size() < request_end) {
+      const auto received = ::recv(connection, chunk, sizeof(chunk), 0);
+
+      if (received <= 0) {
+        return;
+      }
+
+      buffer.append(chunk, static_cast<size_t>(received));
+    }
+
+    const auto keep_alive = head.find("\r\nconnection: close") == std::string::npos;
+    const auto accept_encoding = head.find("\r\naccept-encoding:");
+    const auto accepts_gzip = accept_encoding != std::string::npos && head.find("gzip", accept_encoding) < head.find("\r\n", accept_encoding + 2);
+    const auto response = respond(method, target, head.find("\r\nauthorization:") != std::string::npos, accepts_gzip);
+
+    buffer.erase(0, request_end);
+
+    for (size_t sent = 0; sent < response.size();) {
+      const auto written = ::send(connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+
+      if (written <= 0) {
+        return;
+      }
+
+      sent += static_cast<size_t>(written);
+    }
+
+    if (!keep_alive) {
+      return;
+    }
+  }
+}
+
+void server::stop() {
+  if (!m_running.exchange(false)) {
+    return;
+  }
+
+  /**
+   * Taking the lock first makes sure an acceptor backing off is either already waiting, or sees m_running once it does.
+   */
+  {
+    std::lock_guard lock{m_mutex};
+  }
+
+  m_idle.notify_all();
+
+  /**
+   * shutdown wakes up a blocked accept. The socket is only closed once the acceptor has exited, so it never accepts on a reused descriptor.
+   */
+  ::shutdown(m_socket, SHUT_RDWR);
+
+  if (m_acceptor.joinable()) {
+    m_acceptor.join();
+  }
+
+  ::close(m_socket);
+
+  std::unique_lock lock{m_mutex};
+
+  for (const auto connection: m_connections) {
+    ::shutdown(connection, SHUT_RDWR);
+  }
+
+  m_idle.wait(lock, [this]() {
+    return m_connections.empty();
+  });
+}
+
+server::~server() {
+  stop();
+}
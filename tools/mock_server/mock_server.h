@@ -0,0 +1,201 @@
+/**
+ * @module topgg
+ * @file mock_server.h
+ * @brief A local mock of the Top.gg API, for testing and benchmarking without network access.
+ * @authors Top.gg, null8626
+ * @copyright Copyright (c) 2024 Top.gg & null8626
+ * @date 2024-07-12
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+namespace topgg::mock {
+  /**
+   * @brief Options of the mock Top.gg API server.
+   *
+   * @since 2.1.0
+   */
+  struct options {
+    /**
+     * @brief The port to listen on. Zero picks a free port.
+     *
+     * @since 2.1.0
+     */
+    uint16_t port = 0;
+
+    /**
+     * @brief The artificial latency added before every response.
+     *
+     * @since 2.1.0
+     */
+    std::chrono::milliseconds latency{0};
+
+    /**
+     * @brief Responds with a 429 to every n-th request. Zero disables ratelimit injection.
+     *
+     * @since 2.1.0
+     */
+    size_t ratelimit_every = 0;
+
+    /**
+     * @brief The retry_after value sent with injected 429 responses, in seconds.
+     *
+     * @since 2.1.0
+     */
+    uint16_t retry_after = 1;
+
+    /**
+     * @brief The amount of voters returned by /bots/votes.
+     *
+     * @since 2.1.0
+     */
+    size_t voters = 100;
+
+    /**
+     * @brief Whether to gzip-compress response bodies for requests that accept it.
+     *
+     * @since 2.1.0
+     */
+    bool gzip = false;
+  };
+
+  /**
+   * @brief Generates a canned /bots/:id response body.
+   *
+   * @param id The bot's ID.
+   * @return std::string The response body.
+   * @since 2.1.0
+   */
+  std::string bot_json(const uint64_t id);
+
+  /**
+   * @brief Generates a canned /users/:id response body.
+   *
+   * @param id The user's ID.
+   * @return std::string The response body.
+   * @since 2.1.0
+   */
+  std::string user_json(const uint64_t id);
+
+  /**
+   * @brief Generates a /users/:id response body with only the required fields set. Every optional field is null or missing.
+   *
+   * @param id The user's ID.
+   * @return std::string The response body.
+   * @since 2.1.0
+   */
+  std::string sparse_user_json(const uint64_t id);
+
+  /**
+   * @brief Generates a canned /bots/votes response body.
+   *
+   * @param count The amount of voters.
+   * @return std::string The response body.
+   * @since 2.1.0
+   */
+  std::string voters_json(const size_t count);
+
+  /**
+   * @brief Generates a canned /bots/stats response body.
+   *
+   * @param shards The amount of shards.
+   * @return std::string The response body.
+   * @since 2.1.0
+   */
+  std::string stats_json(const size_t shards);
+
+  /**
+   * @brief Compresses a response body with gzip.
+   *
+   * @param body The response body.
+   * @return std::string The compressed response body.
+   * @throw std::runtime_error Throws if the body can't be compressed.
+   * @since 2.1.0
+   */
+  std::string gzip(const std::string& body);
+
+  /**
+   * @brief A minimal HTTP/1.1 server answering Top.gg API routes with canned responses.
+   *
+   * Serves GET /api/bots/:id, /api/users/:id, /api/bots/votes (with or without ?userId=), /api/bots/stats, /api/weekend and POST /api/bots/stats.
+   * Requests without an Authorization header get a 401.
+   * If gzip is enabled, responses to requests with an Accept-Encoding header listing gzip are compressed.
+   *
+   * @since 2.1.0
+   */
+  class server {
+    options m_options;
+    std::string m_voters;
+    std::string m_voters_gzip;
+    int m_socket;
+    uint16_t m_port;
+    std::atomic_bool m_running;
+    std::atomic_size_t m_requests;
+    std::thread m_acceptor;
+    std::mutex m_mutex;
+    std::condition_variable m_idle;
+    std::vector<int> m_connections;
+
+    void accept_loop();
+    void serve(const int connection);
+    void handle(const int connection);
+    std::string respond(const std::string& method, const std::string& target, const bool authorized, const bool accepts_gzip);
+
+  public:
+    server() = delete;
+
+    /**
+     * @brief Starts listening on 127.0.0.1.
+     *
+     * @param opts The server's options.
+     * @throw std::runtime_error Throws if the socket can't be bound.
+     * @since 2.1.0
+     */
+    server(const options& opts);
+
+    server(const server& other) = delete;
+    server& operator=(const server& other) = delete;
+
+    /**
+     * @brief Returns the port this server listens on.
+     *
+     * @return uint16_t The port this server listens on.
+     * @since 2.1.0
+     */
+    inline uint16_t port() const noexcept {
+      return m_port;
+    }
+
+    /**
+     * @brief Returns the amount of requests served so far.
+     *
+     * @return size_t The amount of requests served so far.
+     * @since 2.1.0
+     */
+    inline size_t requests() const noexcept {
+      return m_requests.load();
+    }
+
+    /**
+     * @brief Stops the server and closes every open connection.
+     *
+     * @since 2.1.0
+     */
+    void stop();
+
+    /**
+     * @brief The destructor. Stops the server if it's running.
+     */
+    ~server();
+  };
+}; // namespace topgg::mock